@@ -3,3 +3,5 @@
 
 MIRYOKU_KLUDGE_THUMBCOMBOS=yes
 MACCEL_ENABLE=yes
+MIRYOKU_MACCEL_FIXED=yes
+MIRYOKU_SMOOTH_SCROLL=yes
@@ -0,0 +1,4 @@
+# Copyright 2026 pehweihang
+# https://github.com/pehweihang/qmk_userspace
+
+MIRYOKU_COMPACT_KEYMAP=yes
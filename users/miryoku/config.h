@@ -15,11 +15,44 @@
 // Enable rapid switch from tap to hold, disables double tap hold auto-repeat.
 #define QUICK_TAP_TERM 0
 
+// Bilateral Combinations: settle mod-taps on the next press, then pick tap or
+// hold from the hands of the two keys.  The thumbs variant does the same for
+// layer-taps, from the working hand of the layer.
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+  #define HOLD_ON_OTHER_KEY_PRESS_PER_KEY
+#endif
+
+// Flow Tap: tap-hold keys pressed within this many ms of the previous key are
+// taps.  Home row mods and LT(U_BUTTON, ...) use the MODS term, thumb
+// layer-taps use the THUMBS term.  0 disables a class.
+#if defined (MIRYOKU_FLOW_TAP)
+  #if !defined (MIRYOKU_FLOW_TAP_TERM_MODS)
+    #define MIRYOKU_FLOW_TAP_TERM_MODS 150
+  #endif
+  #if !defined (MIRYOKU_FLOW_TAP_TERM_THUMBS)
+    #define MIRYOKU_FLOW_TAP_TERM_THUMBS 0
+  #endif
+#endif
+
+// Adaptive tapping term: mod-tap and layer-tap terms follow typing speed.
+#if defined (MIRYOKU_ADAPTIVE_TAPPING_TERM)
+  #define TAPPING_TERM_PER_KEY
+#endif
+
 // Auto Shift
 #define NO_AUTO_SHIFT_ALPHA
 #define AUTO_SHIFT_TIMEOUT TAPPING_TERM
 #define AUTO_SHIFT_NO_SETUP
 
+// Adaptive Auto Shift: per-key timeouts, kept in the user EEPROM datablock.
+#if defined (MIRYOKU_AUTO_SHIFT_ADAPT)
+  #define AUTO_SHIFT_TIMEOUT_PER_KEY
+  #if !defined (EECONFIG_USER_DATA_SIZE) || EECONFIG_USER_DATA_SIZE < 13
+    #undef EECONFIG_USER_DATA_SIZE
+    #define EECONFIG_USER_DATA_SIZE 13
+  #endif
+#endif
+
 // Mouse key speed and acceleration.
 #undef MOUSEKEY_DELAY
 #define MOUSEKEY_DELAY          0
@@ -32,6 +65,22 @@
 #undef MOUSEKEY_TIME_TO_MAX
 #define MOUSEKEY_TIME_TO_MAX    64
 
+
+// Smooth Scroll: high-resolution wheel reports, 16 bit so that full detents
+// at the resolution multiplier still fit.
+#if defined (MIRYOKU_SMOOTH_SCROLL)
+  #define POINTING_DEVICE_HIRES_SCROLL_ENABLE
+  #define WHEEL_EXTENDED_REPORT
+#endif
+
+
+// Split Sync: layer and modifier state sent to the secondary half over a user
+// transaction.
+#if defined (MIRYOKU_SPLIT_SYNC)
+  #define SPLIT_TRANSACTION_IDS_USER U_SPLIT_SYNC
+#endif
+
+
 // Thumb Combos
 #if defined (MIRYOKU_KLUDGE_THUMBCOMBOS)
   #define COMBO_TERM 200
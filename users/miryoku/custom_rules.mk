@@ -6,3 +6,5 @@ MIRYOKU_ALPHAS=COLEMAKDH
 MIRYOKU_EXTRA=QWERTY
 MIRYOKU_NAV=VI
 MIRYOKU_CLIPBOARD=WIN
+MIRYOKU_FLOW_TAP=yes
+MIRYOKU_GENERATED_LAYERS=yes
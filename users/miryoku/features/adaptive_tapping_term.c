@@ -0,0 +1,88 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "adaptive_tapping_term.h"
+
+#include "manna-harbour_miryoku.h"
+
+// ms per press at a given words per minute
+#define U_ATT_INTERVAL(WPM) (60000 / 5 / (WPM))
+
+// Average interval in 1/16 ms, starting slow.
+static uint16_t u_att_interval = MIRYOKU_ADAPTIVE_TAPPING_TERM_PAUSE * 16;
+static uint32_t u_att_last     = 0;
+static bool     u_att_started  = false;
+static uint16_t u_att_term     = MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING;
+
+static uint16_t u_att_interval_ms(void) {
+    return (u_att_interval + 8) / 16;
+}
+
+uint8_t adaptive_tapping_term_wpm(void) {
+    uint16_t interval = u_att_interval_ms();
+    uint16_t wpm      = interval ? U_ATT_INTERVAL(1) / interval : UINT8_MAX;
+    return wpm < UINT8_MAX ? wpm : UINT8_MAX;
+}
+
+static uint16_t u_att_term_for(uint8_t wpm) {
+    if (wpm <= MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW) {
+        return MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING;
+    }
+    if (wpm >= MIRYOKU_ADAPTIVE_TAPPING_TERM_FAST) {
+        return MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR;
+    }
+    return MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING - (uint32_t)(MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING - MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR) * (wpm - MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW) / (MIRYOKU_ADAPTIVE_TAPPING_TERM_FAST - MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW);
+}
+
+void adaptive_tapping_term_record(keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event) || !record->event.pressed) {
+        return;
+    }
+    // the event time widened to 32 bits, so long idle gaps do not wrap
+    const uint32_t time     = timer_read32() - TIMER_DIFF_16(timer_read(), record->event.time);
+    const uint32_t interval = time - u_att_last;
+    const bool     pause    = !u_att_started || interval >= MIRYOKU_ADAPTIVE_TAPPING_TERM_PAUSE;
+    u_att_last    = time;
+    u_att_started = true;
+
+    if (pause) {
+        u_att_interval = MIRYOKU_ADAPTIVE_TAPPING_TERM_PAUSE * 16;
+    } else {
+        int32_t error = (int32_t)interval * 16 - u_att_interval;
+        u_att_interval += error / (1 << MIRYOKU_ADAPTIVE_TAPPING_TERM_SMOOTHING);
+    }
+    u_att_term = u_att_term_for(adaptive_tapping_term_wpm());
+}
+
+uint16_t adaptive_tapping_term_get(void) {
+    return u_att_term;
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        return u_att_term;
+    }
+    return TAPPING_TERM;
+}
+
+static void u_att_put16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+bool adaptive_tapping_term_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 11 || data[0] != U_RAW_HID_TAPPING_TERM) {
+        return false;
+    }
+    memset(&data[2], 0, length - 2);
+    if (data[1] == ADAPTIVE_TAPPING_TERM_GET) {
+        u_att_put16(&data[2], u_att_term);
+        u_att_put16(&data[4], u_att_interval_ms());
+        data[6] = adaptive_tapping_term_wpm();
+        u_att_put16(&data[7], MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR);
+        u_att_put16(&data[9], MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING);
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// The tapping term of mod-taps and layer-taps follows typing speed: CEILING
+// at SLOW words per minute and below, FLOOR at FAST and above, linear between.
+// Speed is estimated from an exponential moving average of the time between
+// key presses, at 5 characters per word.
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR 140
+#endif
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING TAPPING_TERM
+#endif
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW 30
+#endif
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_FAST
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_FAST 90
+#endif
+
+// Weight of each new interval in the average, as a power of two divisor.
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_SMOOTHING
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_SMOOTHING 3
+#endif
+
+// A pause of this many ms or more restarts the average at the pause, which
+// returns the term to the ceiling.
+#ifndef MIRYOKU_ADAPTIVE_TAPPING_TERM_PAUSE
+#    define MIRYOKU_ADAPTIVE_TAPPING_TERM_PAUSE 1000
+#endif
+
+_Static_assert(MIRYOKU_ADAPTIVE_TAPPING_TERM_FLOOR <= MIRYOKU_ADAPTIVE_TAPPING_TERM_CEILING, "adaptive tapping term floor above ceiling");
+_Static_assert(MIRYOKU_ADAPTIVE_TAPPING_TERM_SLOW < MIRYOKU_ADAPTIVE_TAPPING_TERM_FAST, "adaptive tapping term speeds out of order");
+
+// Raw HID, U_RAW_HID_TAPPING_TERM followed by one of these.  Replies echo the
+// two command bytes.  Values are little-endian.
+enum adaptive_tapping_term_commands {
+    ADAPTIVE_TAPPING_TERM_GET, // -> term ms (2), average interval ms (2), wpm (1), floor ms (2), ceiling ms (2)
+};
+
+void     adaptive_tapping_term_record(keyrecord_t *record);
+uint16_t adaptive_tapping_term_get(void);
+uint8_t  adaptive_tapping_term_wpm(void);
+bool     adaptive_tapping_term_raw_hid(uint8_t *data, uint8_t length);
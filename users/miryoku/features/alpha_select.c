@@ -0,0 +1,130 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "alpha_select.h"
+
+#include "manna-harbour_miryoku.h"
+#include "miryoku_babel/miryoku_layer_alternatives.h"
+
+// The alternatives only differ in the basic keycodes of the 30 alpha
+// positions: home row mods, button layer-taps, and thumbs are the same for
+// every alpha.  So one byte per position per alpha is stored, taken from the
+// TAP alternatives, and substituted into the low byte of the compiled BASE,
+// EXTRA, or TAP keycode at lookup.
+
+#define U_ALPHA_POSITIONS 30
+
+#define U_ALPHA_SELECT( \
+K00, K01, K02, K03, K04, K05, K06, K07, K08, K09, \
+K10, K11, K12, K13, K14, K15, K16, K17, K18, K19, \
+K20, K21, K22, K23, K24, K25, K26, K27, K28, K29, \
+N30, N31, K32, K33, K34, K35, K36, K37, N38, N39 \
+) \
+K00, K01, K02, K03, K04, K05, K06, K07, K08, K09, \
+K10, K11, K12, K13, K14, K15, K16, K17, K18, K19, \
+K20, K21, K22, K23, K24, K25, K26, K27, K28, K29
+
+static const uint8_t PROGMEM u_alpha_select_alphas[U_ALPHA_COUNT - 1][U_ALPHA_POSITIONS] = {
+#define MIRYOKU_A(NAME) [U_ALPHA_##NAME - 1] = {U_MACRO_VA_ARGS(U_ALPHA_SELECT, MIRYOKU_ALTERNATIVES_TAP_##NAME)},
+MIRYOKU_ALPHA_SELECT_LIST
+#undef MIRYOKU_A
+};
+
+uint16_t alpha_select_keycode(uint8_t layer, uint8_t position, uint16_t keycode) {
+    if (position >= U_ALPHA_POSITIONS) {
+        return keycode;
+    }
+    uint8_t alpha;
+    switch (layer) {
+        case U_BASE:
+            alpha = miryoku_config.alphas;
+            break;
+        case U_EXTRA:
+            alpha = miryoku_config.extra;
+            break;
+        case U_TAP:
+            alpha = miryoku_config.tap;
+            break;
+        default:
+            return keycode;
+    }
+    if (alpha == U_ALPHA_COMPILED || alpha >= U_ALPHA_COUNT) {
+        return keycode;
+    }
+    return (keycode & 0xFF00) | pgm_read_byte(&u_alpha_select_alphas[alpha - 1][position]);
+}
+
+void alpha_select_set(uint8_t base, uint8_t extra, uint8_t tap) {
+    miryoku_config.alphas = base < U_ALPHA_COUNT ? base : U_ALPHA_COMPILED;
+    miryoku_config.extra  = extra < U_ALPHA_COUNT ? extra : U_ALPHA_COMPILED;
+    miryoku_config.tap    = tap < U_ALPHA_COUNT ? tap : U_ALPHA_COMPILED;
+    eeconfig_update_user(miryoku_config.raw);
+}
+
+static uint8_t u_alpha_select_next(uint8_t alpha) {
+    return (alpha + 1) % U_ALPHA_COUNT;
+}
+
+bool process_alpha_select(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return keycode != U_ALPHAS_NEXT && keycode != U_EXTRA_NEXT && keycode != U_TAP_NEXT;
+    }
+    switch (keycode) {
+        case U_ALPHAS_NEXT:
+            alpha_select_set(u_alpha_select_next(miryoku_config.alphas), miryoku_config.extra, miryoku_config.tap);
+            return false;
+        case U_EXTRA_NEXT:
+            alpha_select_set(miryoku_config.alphas, u_alpha_select_next(miryoku_config.extra), miryoku_config.tap);
+            return false;
+        case U_TAP_NEXT:
+            alpha_select_set(miryoku_config.alphas, miryoku_config.extra, u_alpha_select_next(miryoku_config.tap));
+            return false;
+    }
+    return true;
+}
+
+bool alpha_select_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 6 || data[0] != U_RAW_HID_ALPHA_SELECT) {
+        return false;
+    }
+    if (data[1] == ALPHA_SELECT_SET) {
+        alpha_select_set(data[2], data[3], data[4]);
+    }
+    memset(&data[2], 0, length - 2);
+    data[2] = miryoku_config.alphas;
+    data[3] = miryoku_config.extra;
+    data[4] = miryoku_config.tap;
+    data[5] = U_ALPHA_COUNT;
+    return true;
+}
+
+#if !defined (MIRYOKU_COMPACT_KEYMAP)
+
+// Miryoku alpha position of each matrix position, from the mapping.  Other
+// entries hold whatever keycode the mapping puts there.
+#define U_ALPHA_SELECT_POSITION(INDEX) (0xFF00 | (INDEX))
+#define U_ALPHA_SELECT_IS_POSITION(ENTRY) (((ENTRY) & 0xFF00) == 0xFF00)
+
+#define U_ALPHA_SELECT_POSITIONS_MIRYOKU \
+U_ALPHA_SELECT_POSITION(0),  U_ALPHA_SELECT_POSITION(1),  U_ALPHA_SELECT_POSITION(2),  U_ALPHA_SELECT_POSITION(3),  U_ALPHA_SELECT_POSITION(4),  U_ALPHA_SELECT_POSITION(5),  U_ALPHA_SELECT_POSITION(6),  U_ALPHA_SELECT_POSITION(7),  U_ALPHA_SELECT_POSITION(8),  U_ALPHA_SELECT_POSITION(9),  \
+U_ALPHA_SELECT_POSITION(10), U_ALPHA_SELECT_POSITION(11), U_ALPHA_SELECT_POSITION(12), U_ALPHA_SELECT_POSITION(13), U_ALPHA_SELECT_POSITION(14), U_ALPHA_SELECT_POSITION(15), U_ALPHA_SELECT_POSITION(16), U_ALPHA_SELECT_POSITION(17), U_ALPHA_SELECT_POSITION(18), U_ALPHA_SELECT_POSITION(19), \
+U_ALPHA_SELECT_POSITION(20), U_ALPHA_SELECT_POSITION(21), U_ALPHA_SELECT_POSITION(22), U_ALPHA_SELECT_POSITION(23), U_ALPHA_SELECT_POSITION(24), U_ALPHA_SELECT_POSITION(25), U_ALPHA_SELECT_POSITION(26), U_ALPHA_SELECT_POSITION(27), U_ALPHA_SELECT_POSITION(28), U_ALPHA_SELECT_POSITION(29), \
+KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO,                       KC_NO
+
+static const uint16_t PROGMEM u_alpha_select_matrix[MATRIX_ROWS][MATRIX_COLS] = U_MACRO_VA_ARGS(MIRYOKU_MAPPING, U_ALPHA_SELECT_POSITIONS_MIRYOKU);
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    const uint16_t keycode = keycode_at_keymap_location_raw(layer_num, row, column);
+    if (row >= MATRIX_ROWS || column >= MATRIX_COLS) {
+        return keycode;
+    }
+    const uint16_t entry = pgm_read_word(&u_alpha_select_matrix[row][column]);
+    if (!U_ALPHA_SELECT_IS_POSITION(entry)) {
+        return keycode;
+    }
+    return alpha_select_keycode(layer_num, entry & 0xFF, keycode);
+}
+
+#endif
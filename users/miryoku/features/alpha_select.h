@@ -0,0 +1,43 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Alphas available at runtime, in selection order.  Selection 0 keeps the
+// compiled MIRYOKU_ALPHAS, MIRYOKU_EXTRA, or MIRYOKU_TAP, and selection i the
+// i-th entry here.
+#define MIRYOKU_ALPHA_SELECT_LIST \
+MIRYOKU_A(AZERTY) \
+MIRYOKU_A(BEAKL15) \
+MIRYOKU_A(COLEMAK) \
+MIRYOKU_A(COLEMAKDH) \
+MIRYOKU_A(COLEMAKDHK) \
+MIRYOKU_A(DVORAK) \
+MIRYOKU_A(HALMAK) \
+MIRYOKU_A(WORKMAN) \
+MIRYOKU_A(QWERTY) \
+MIRYOKU_A(QWERTZ)
+
+enum alpha_select_alphas {
+    U_ALPHA_COMPILED,
+#define MIRYOKU_A(NAME) U_ALPHA_##NAME,
+MIRYOKU_ALPHA_SELECT_LIST
+#undef MIRYOKU_A
+    U_ALPHA_COUNT,
+};
+
+// Raw HID, U_RAW_HID_ALPHA_SELECT followed by one of these.  Replies echo the
+// two command bytes.
+enum alpha_select_commands {
+    ALPHA_SELECT_GET, // -> base, extra, tap, count of selections
+    ALPHA_SELECT_SET, // base, extra, tap -> base, extra, tap, count; saved to EEPROM
+};
+
+uint16_t alpha_select_keycode(uint8_t layer, uint8_t position, uint16_t keycode);
+void     alpha_select_set(uint8_t base, uint8_t extra, uint8_t tap);
+bool     process_alpha_select(uint16_t keycode, keyrecord_t *record);
+bool     alpha_select_raw_hid(uint8_t *data, uint8_t length);
@@ -0,0 +1,181 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "auto_shift_adapt.h"
+
+#if defined (MIRYOKU_SCHEDULER)
+  #include "scheduler.h"
+#endif
+
+#define U_ASA_MAGIC 0xA5
+#define U_ASA_STEPS 16
+#define U_ASA_NONE 0xFF
+
+// Tap durations below the timeout are taps.  Each key keeps an exponential
+// moving average of them and of their deviation, 1/8 weight, in 1/16 ms.
+typedef struct {
+    uint16_t mean;
+    uint16_t deviation;
+    uint16_t pressed;
+    uint8_t  samples;
+} u_asa_key_t;
+
+static auto_shift_adapt_eeprom_t u_asa_eeprom;
+static u_asa_key_t               u_asa_keys[AUTO_SHIFT_ADAPT_KEYS];
+static uint32_t                  u_asa_down = 0;
+
+static bool     u_asa_dirty      = false;
+static uint32_t u_asa_saved      = 0;
+static uint32_t u_asa_last_press = 0;
+static uint8_t  u_asa_shifted    = U_ASA_NONE;
+static uint16_t u_asa_shifted_at = 0;
+
+_Static_assert(AUTO_SHIFT_ADAPT_KEYS <= 32, "u_asa_down is one bit per key");
+
+static uint8_t u_asa_index(uint16_t keycode) {
+    if (keycode >= KC_1 && keycode <= KC_0) {
+        return keycode - KC_1;
+    }
+    if (keycode >= KC_MINS && keycode <= KC_SLSH) {
+        return 10 + keycode - KC_MINS;
+    }
+    if (keycode == KC_NUBS) {
+        return AUTO_SHIFT_ADAPT_KEYS - 1;
+    }
+    return U_ASA_NONE;
+}
+
+static uint8_t u_asa_step_get(uint8_t index) {
+    return (u_asa_eeprom.steps[index / 2] >> (index % 2 * 4)) & 0x0F;
+}
+
+static void u_asa_step_set(uint8_t index, uint8_t step) {
+    if (step == u_asa_step_get(index)) {
+        return;
+    }
+    uint8_t shift = index % 2 * 4;
+    u_asa_eeprom.steps[index / 2] = (u_asa_eeprom.steps[index / 2] & ~(0x0F << shift)) | (step << shift);
+    u_asa_dirty = true;
+}
+
+static uint8_t u_asa_step_for(uint32_t ms) {
+    if (ms <= MIRYOKU_AUTO_SHIFT_ADAPT_MIN) {
+        return 0;
+    }
+    uint32_t step = (ms - MIRYOKU_AUTO_SHIFT_ADAPT_MIN + MIRYOKU_AUTO_SHIFT_ADAPT_STEP - 1) / MIRYOKU_AUTO_SHIFT_ADAPT_STEP;
+    return step < U_ASA_STEPS ? step : U_ASA_STEPS - 1;
+}
+
+static uint16_t u_asa_timeout(uint8_t index) {
+    return MIRYOKU_AUTO_SHIFT_ADAPT_MIN + u_asa_step_get(index) * MIRYOKU_AUTO_SHIFT_ADAPT_STEP;
+}
+
+static void u_asa_learn(uint8_t index, uint16_t duration) {
+    u_asa_key_t *key    = &u_asa_keys[index];
+    int32_t      sample = (int32_t)duration * 16;
+    if (key->samples == 0) {
+        key->mean      = sample;
+        key->deviation = sample / 8;
+    } else {
+        int32_t error = sample - key->mean;
+        key->mean += error / 8;
+        key->deviation += ((error < 0 ? -error : error) - (int32_t)key->deviation) / 8;
+    }
+    if (key->samples < UINT8_MAX) {
+        key->samples++;
+    }
+    if (key->samples >= MIRYOKU_AUTO_SHIFT_ADAPT_SAMPLES) {
+        uint32_t target = ((uint32_t)key->mean + (uint32_t)key->deviation * MIRYOKU_AUTO_SHIFT_ADAPT_DEVIATIONS + 15) / 16;
+        u_asa_step_set(index, u_asa_step_for(target));
+    }
+}
+
+static bool u_asa_is_backspace(uint16_t keycode, keyrecord_t *record) {
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return record->tap.count && QK_LAYER_TAP_GET_TAP_KEYCODE(keycode) == KC_BSPC;
+    }
+    if (IS_QK_MOD_TAP(keycode)) {
+        return record->tap.count && QK_MOD_TAP_GET_TAP_KEYCODE(keycode) == KC_BSPC;
+    }
+    return keycode == KC_BSPC;
+}
+
+// the later of the save interval and the idle time, while there are changes
+static void u_asa_schedule(void) {
+#if defined (MIRYOKU_SCHEDULER)
+    if (u_asa_dirty) {
+        uint32_t interval = u_asa_saved + MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_INTERVAL;
+        uint32_t idle     = u_asa_last_press + MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_IDLE;
+        scheduler_set(SCHEDULER_AUTO_SHIFT_ADAPT, (int32_t)(interval - idle) > 0 ? interval : idle, auto_shift_adapt_task);
+    }
+#endif
+}
+
+void auto_shift_adapt_init(void) {
+    eeconfig_read_user_datablock(&u_asa_eeprom, 0, sizeof(u_asa_eeprom));
+    if (u_asa_eeprom.magic != U_ASA_MAGIC) {
+        uint8_t step       = u_asa_step_for(AUTO_SHIFT_TIMEOUT);
+        u_asa_eeprom.magic = U_ASA_MAGIC;
+        memset(u_asa_eeprom.steps, step | step << 4, sizeof(u_asa_eeprom.steps));
+        u_asa_dirty = true;
+    }
+    u_asa_saved = timer_read32();
+    u_asa_schedule();
+}
+
+uint16_t get_autoshift_timeout(uint16_t keycode, keyrecord_t *record) {
+    uint8_t index = u_asa_index(keycode);
+    return index == U_ASA_NONE ? get_generic_autoshift_timeout() : u_asa_timeout(index);
+}
+
+bool process_auto_shift_adapt(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return true;
+    }
+    uint8_t index = u_asa_index(keycode);
+
+    if (record->event.pressed) {
+        u_asa_last_press = timer_read32();
+        if (u_asa_shifted != U_ASA_NONE && u_asa_is_backspace(keycode, record) &&
+            TIMER_DIFF_16(record->event.time, u_asa_shifted_at) < MIRYOKU_AUTO_SHIFT_ADAPT_CORRECTION) {
+            uint8_t step = u_asa_step_get(u_asa_shifted);
+            if (step < U_ASA_STEPS - 1) {
+                u_asa_step_set(u_asa_shifted, step + 1);
+            }
+            // the estimate starts over above the corrected timeout
+            u_asa_keys[u_asa_shifted].samples = 0;
+        }
+        u_asa_shifted = U_ASA_NONE;
+        if (index != U_ASA_NONE) {
+            u_asa_keys[index].pressed = record->event.time;
+            u_asa_down |= (uint32_t)1 << index;
+        }
+        u_asa_schedule();
+        return true;
+    }
+
+    if (index != U_ASA_NONE && (u_asa_down & ((uint32_t)1 << index))) {
+        u_asa_down &= ~((uint32_t)1 << index);
+        uint16_t duration = TIMER_DIFF_16(record->event.time, u_asa_keys[index].pressed);
+        if (duration < u_asa_timeout(index)) {
+            u_asa_learn(index, duration);
+        } else {
+            u_asa_shifted    = index;
+            u_asa_shifted_at = record->event.time;
+        }
+        u_asa_schedule();
+    }
+    return true;
+}
+
+void auto_shift_adapt_task(void) {
+    if (u_asa_dirty && timer_elapsed32(u_asa_saved) >= MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_INTERVAL &&
+        timer_elapsed32(u_asa_last_press) >= MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_IDLE) {
+        eeconfig_update_user_datablock(&u_asa_eeprom, 0, sizeof(u_asa_eeprom));
+        u_asa_dirty = false;
+        u_asa_saved = timer_read32();
+    }
+    u_asa_schedule();
+}
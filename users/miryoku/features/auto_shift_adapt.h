@@ -0,0 +1,53 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Per-key Auto Shift timeouts for the number and symbol keys, learned from
+// their tap durations as mean + DEVIATIONS mean deviations.  Timeouts are kept
+// as 4 bit steps of STEP ms above MIN, 16 steps, two keys to a byte.
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_MIN
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_MIN 100
+#endif
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_STEP
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_STEP 10
+#endif
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_DEVIATIONS
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_DEVIATIONS 4
+#endif
+
+// Taps of a key before its timeout moves.
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_SAMPLES
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_SAMPLES 8
+#endif
+
+// A shifted key followed by Backspace within this many ms was meant as a tap,
+// and raises its timeout by a step.
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_CORRECTION
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_CORRECTION 1000
+#endif
+
+// Changed timeouts are written to EEPROM at most once per SAVE_INTERVAL ms,
+// and only after SAVE_IDLE ms without a key press.
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_INTERVAL
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_INTERVAL 600000
+#endif
+#ifndef MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_IDLE
+#    define MIRYOKU_AUTO_SHIFT_ADAPT_SAVE_IDLE 5000
+#endif
+
+// 1 to 0, - to /, and the non-US backslash
+#define AUTO_SHIFT_ADAPT_KEYS 23
+
+typedef struct {
+    uint8_t magic;
+    uint8_t steps[(AUTO_SHIFT_ADAPT_KEYS + 1) / 2];
+} auto_shift_adapt_eeprom_t;
+
+void auto_shift_adapt_init(void);
+bool process_auto_shift_adapt(uint16_t keycode, keyrecord_t *record);
+void auto_shift_adapt_task(void);
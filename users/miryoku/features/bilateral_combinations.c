@@ -0,0 +1,201 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "bilateral_combinations.h"
+
+#include "manna-harbour_miryoku.h"
+
+#if defined (MIRYOKU_SCHEDULER)
+  #include "scheduler.h"
+#endif
+
+// hand table, mapped onto the matrix the same way as the keymap
+
+#define MIRYOKU_HANDS \
+U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, \
+U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, \
+U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, \
+U_HAND_NONE,  U_HAND_NONE,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_LEFT,  U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_RIGHT, U_HAND_NONE,  U_HAND_NONE
+
+static const uint8_t PROGMEM miryoku_hands[MATRIX_ROWS][MATRIX_COLS] = U_MACRO_VA_ARGS(MIRYOKU_MAPPING, MIRYOKU_HANDS);
+
+uint8_t miryoku_hand(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return U_HAND_NONE;
+    }
+    uint8_t hand = pgm_read_byte(&miryoku_hands[key.row][key.col]);
+    return hand == U_HAND_LEFT || hand == U_HAND_RIGHT ? hand : U_HAND_NONE;
+}
+
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+
+// The mod-tap is intercepted when QMK settles it as held on another key press
+// (see get_hold_on_other_key_press), held back, and replayed as a tap or a hold
+// once the next press shows which hand it is on.
+
+typedef enum {
+    U_BC_RELEASED,  // no mod-tap held back
+    U_BC_UNSETTLED, // mod-tap held back, waiting on the next press
+    U_BC_HOLDING,   // replayed as hold
+    U_BC_TAPPING,   // replayed as tap, waiting on release
+} u_bc_state_t;
+
+static u_bc_state_t u_bc_state     = U_BC_RELEASED;
+static bool         u_bc_replaying = false;
+static uint16_t     u_bc_keycode   = KC_NO;
+static uint8_t      u_bc_hold_hand = U_HAND_NONE; // layer-taps: next key on this hand holds
+static keyrecord_t  u_bc_record;
+
+#if defined (BILATERAL_COMBINATIONS_THUMBS)
+// Working hand of each layer, opposite the hand of the layer-taps that reach
+// it.  Layers reached from both hands, such as Button, are left to QMK.
+static uint8_t u_bc_layer_hands[] = {
+#define MIRYOKU_X(LAYER, STRING) [U_##LAYER] = U_HAND_NONE,
+MIRYOKU_LAYER_LIST
+#undef MIRYOKU_X
+};
+
+static uint8_t u_bc_layer_hand(uint8_t layer) {
+    if (layer >= sizeof(u_bc_layer_hands)) {
+        return U_HAND_NONE;
+    }
+    uint8_t hand = u_bc_layer_hands[layer];
+    return hand == U_HAND_LEFT || hand == U_HAND_RIGHT ? hand : U_HAND_NONE;
+}
+
+static void u_bc_scan(uint8_t layer, keypos_t key, uint8_t hand) {
+    uint16_t keycode = keymap_key_to_keycode(layer, key);
+    if (IS_QK_LAYER_TAP(keycode) && QK_LAYER_TAP_GET_LAYER(keycode) < sizeof(u_bc_layer_hands)) {
+        u_bc_layer_hands[QK_LAYER_TAP_GET_LAYER(keycode)] |= hand == U_HAND_LEFT ? U_HAND_RIGHT : U_HAND_LEFT;
+    }
+}
+
+void bilateral_combinations_init(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key  = {.row = row, .col = col};
+            uint8_t  hand = miryoku_hand(key);
+            if (hand == U_HAND_NONE) {
+                continue;
+            }
+#define MIRYOKU_X(LAYER, STRING) u_bc_scan(U_##LAYER, key, hand);
+MIRYOKU_LAYER_LIST
+#undef MIRYOKU_X
+        }
+    }
+}
+#endif
+
+bool bilateral_combinations_key(uint16_t keycode) {
+#if defined (BILATERAL_COMBINATIONS)
+    if (IS_QK_MOD_TAP(keycode)) {
+        return true;
+    }
+#endif
+#if defined (BILATERAL_COMBINATIONS_THUMBS)
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return u_bc_layer_hand(QK_LAYER_TAP_GET_LAYER(keycode)) != U_HAND_NONE;
+    }
+#endif
+    return false;
+}
+
+static void u_bc_replay(keyrecord_t *record) {
+    u_bc_replaying = true;
+    process_record(record);
+    u_bc_replaying = false;
+}
+
+static void u_bc_settle_as_hold(void) {
+    u_bc_state = U_BC_HOLDING;
+    u_bc_replay(&u_bc_record);
+}
+
+static void u_bc_settle_as_tap(void) {
+    u_bc_state                  = U_BC_TAPPING;
+    u_bc_record.tap.count       = 1;
+    u_bc_record.tap.interrupted = false;
+    u_bc_replay(&u_bc_record);
+    u_bc_record.event.pressed = false;
+    u_bc_record.event.time    = timer_read();
+    u_bc_replay(&u_bc_record);
+}
+
+static bool u_bc_same_hand(keyrecord_t *record) {
+    uint8_t hand = miryoku_hand(u_bc_record.event.key);
+    return hand != U_HAND_NONE && hand == miryoku_hand(record->event.key);
+}
+
+static bool u_bc_holds(keyrecord_t *record) {
+    if (u_bc_hold_hand != U_HAND_NONE) {
+        return miryoku_hand(record->event.key) == u_bc_hold_hand;
+    }
+    return !u_bc_same_hand(record);
+}
+
+bool process_bilateral_combinations(uint16_t keycode, keyrecord_t *record) {
+    if (u_bc_replaying) {
+        return true;
+    }
+
+    if (u_bc_state == U_BC_RELEASED) {
+        // Only keys QMK settled as held before the tapping term expired.
+        if (bilateral_combinations_key(keycode) && IS_KEYEVENT(record->event) && record->event.pressed && record->tap.count == 0 &&
+            timer_elapsed(record->event.time) < GET_TAPPING_TERM(keycode, record)) {
+            u_bc_state     = U_BC_UNSETTLED;
+            u_bc_keycode   = keycode;
+            u_bc_hold_hand = U_HAND_NONE;
+#if defined (BILATERAL_COMBINATIONS_THUMBS)
+            if (IS_QK_LAYER_TAP(keycode)) {
+                u_bc_hold_hand = u_bc_layer_hand(QK_LAYER_TAP_GET_LAYER(keycode));
+            }
+#endif
+            u_bc_record = *record;
+#if defined (MIRYOKU_SCHEDULER)
+            scheduler_set(SCHEDULER_BILATERAL_COMBINATIONS, timer_read32() + GET_TAPPING_TERM(keycode, record) - timer_elapsed(record->event.time), bilateral_combinations_task);
+#endif
+            return false;
+        }
+        return true;
+    }
+
+    if (!record->event.pressed && keycode == u_bc_keycode && KEYEQ(record->event.key, u_bc_record.event.key)) {
+        u_bc_state_t state = u_bc_state;
+        u_bc_state         = U_BC_RELEASED;
+        u_bc_keycode       = KC_NO;
+        switch (state) {
+            case U_BC_UNSETTLED:
+                // released before any other press reached us
+                u_bc_settle_as_tap();
+                u_bc_state = U_BC_RELEASED;
+                return false;
+            case U_BC_TAPPING:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    if (u_bc_state == U_BC_UNSETTLED && record->event.pressed) {
+        // Non-key events and other held tap-hold keys chord as usual.
+        if (!IS_KEYEVENT(record->event) || ((IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) && record->tap.count == 0) || u_bc_holds(record)) {
+            u_bc_settle_as_hold();
+        } else {
+            u_bc_settle_as_tap();
+        }
+        u_bc_replay(record);
+        return false;
+    }
+
+    return true;
+}
+
+void bilateral_combinations_task(void) {
+    if (u_bc_state == U_BC_UNSETTLED && timer_elapsed(u_bc_record.event.time) >= GET_TAPPING_TERM(u_bc_keycode, &u_bc_record)) {
+        u_bc_settle_as_hold();
+    }
+}
+
+#endif
@@ -0,0 +1,27 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Hand of each LAYOUT_miryoku position.  Values are chosen outside the range
+// of keycodes that subset mappings hardcode into their unused positions.
+enum miryoku_hands {
+    U_HAND_NONE  = 0, // KC_NO, position not on either hand
+    U_HAND_LEFT  = 1,
+    U_HAND_RIGHT = 2,
+};
+
+uint8_t miryoku_hand(keypos_t key);
+
+// Mod-taps settled as held by QMK are resolved here: tap if the next key is on
+// the same hand, hold if it is on the opposite hand.  With
+// BILATERAL_COMBINATIONS_THUMBS, layer-taps are resolved the same way by the
+// working hand of their layer: hold if the next key is on it, tap otherwise.
+bool process_bilateral_combinations(uint16_t keycode, keyrecord_t *record);
+bool bilateral_combinations_key(uint16_t keycode);
+void bilateral_combinations_init(void);
+void bilateral_combinations_task(void);
@@ -0,0 +1,62 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include QMK_KEYBOARD_H
+
+#include "manna-harbour_miryoku.h"
+#if defined (MIRYOKU_ALPHA_SELECT)
+  #include "alpha_select.h"
+#endif
+
+// Compact keymap.  Only the 36 used LAYOUT_miryoku positions are stored per
+// layer, and a single matrix-sized table maps each matrix position to its
+// Miryoku position, or holds the keycode the subset mapping puts there
+// (usually KC_NO).  Overriding keycode_at_keymap_location leaves the dense
+// keymaps[] array unreferenced, so it is dropped at link time.  All layers
+// use MIRYOKU_MAPPING.
+
+#define U_COMPACT_POSITIONS 36
+#define U_COMPACT_POSITION(INDEX) (0xFF00 | (INDEX))
+#define U_COMPACT_IS_POSITION(ENTRY) (((ENTRY) & 0xFF00) == 0xFF00)
+
+#define U_COMPACT( \
+K00, K01, K02, K03, K04, K05, K06, K07, K08, K09, \
+K10, K11, K12, K13, K14, K15, K16, K17, K18, K19, \
+K20, K21, K22, K23, K24, K25, K26, K27, K28, K29, \
+N30, N31, K32, K33, K34, K35, K36, K37, N38, N39 \
+) \
+K00, K01, K02, K03, K04, K05, K06, K07, K08, K09, \
+K10, K11, K12, K13, K14, K15, K16, K17, K18, K19, \
+K20, K21, K22, K23, K24, K25, K26, K27, K28, K29, \
+K32, K33, K34, K35, K36, K37
+
+#define U_COMPACT_POSITIONS_MIRYOKU \
+U_COMPACT_POSITION(0),  U_COMPACT_POSITION(1),  U_COMPACT_POSITION(2),  U_COMPACT_POSITION(3),  U_COMPACT_POSITION(4),  U_COMPACT_POSITION(5),  U_COMPACT_POSITION(6),  U_COMPACT_POSITION(7),  U_COMPACT_POSITION(8),  U_COMPACT_POSITION(9),  \
+U_COMPACT_POSITION(10), U_COMPACT_POSITION(11), U_COMPACT_POSITION(12), U_COMPACT_POSITION(13), U_COMPACT_POSITION(14), U_COMPACT_POSITION(15), U_COMPACT_POSITION(16), U_COMPACT_POSITION(17), U_COMPACT_POSITION(18), U_COMPACT_POSITION(19), \
+U_COMPACT_POSITION(20), U_COMPACT_POSITION(21), U_COMPACT_POSITION(22), U_COMPACT_POSITION(23), U_COMPACT_POSITION(24), U_COMPACT_POSITION(25), U_COMPACT_POSITION(26), U_COMPACT_POSITION(27), U_COMPACT_POSITION(28), U_COMPACT_POSITION(29), \
+KC_NO,                  KC_NO,                  U_COMPACT_POSITION(30), U_COMPACT_POSITION(31), U_COMPACT_POSITION(32), U_COMPACT_POSITION(33), U_COMPACT_POSITION(34), U_COMPACT_POSITION(35), KC_NO,                  KC_NO
+
+static const uint16_t PROGMEM u_compact_layers[][U_COMPACT_POSITIONS] = {
+#define MIRYOKU_X(LAYER, STRING) [U_##LAYER] = {U_MACRO_VA_ARGS(U_COMPACT, MIRYOKU_LAYER_##LAYER)},
+MIRYOKU_LAYER_LIST
+#undef MIRYOKU_X
+};
+
+static const uint16_t PROGMEM u_compact_matrix[MATRIX_ROWS][MATRIX_COLS] = U_MACRO_VA_ARGS(MIRYOKU_MAPPING, U_COMPACT_POSITIONS_MIRYOKU);
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num >= sizeof(u_compact_layers) / sizeof(u_compact_layers[0]) || row >= MATRIX_ROWS || column >= MATRIX_COLS) {
+        return KC_NO;
+    }
+    uint16_t entry = pgm_read_word(&u_compact_matrix[row][column]);
+    if (!U_COMPACT_IS_POSITION(entry)) {
+        return entry;
+    }
+    uint16_t keycode = pgm_read_word(&u_compact_layers[layer_num][entry & 0xFF]);
+#if defined (MIRYOKU_ALPHA_SELECT)
+    keycode = alpha_select_keycode(layer_num, entry & 0xFF, keycode);
+#endif
+    return keycode;
+}
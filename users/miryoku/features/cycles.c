@@ -0,0 +1,74 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "cycles.h"
+
+#if defined (CYCLES_AVR_TIMER)
+#    include <avr/io.h>
+#    include <avr/interrupt.h>
+#endif
+
+#if defined (CYCLES_COUNTER) || defined (CYCLES_AVR_TIMER)
+static uint32_t cycles_rate = 0;
+#elif defined (CYCLES_RP_TIMER)
+static const uint32_t cycles_rate = 1000;
+#else
+static const uint32_t cycles_rate = 0;
+#endif
+#if defined (CYCLES_COUNTER)
+static uint32_t cycles_calibrate_ms;
+static uint32_t cycles_calibrate_start;
+#endif
+
+void cycles_init(void) {
+#if defined (CYCLES_COUNTER)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cycles_calibrate_ms    = timer_read32();
+    cycles_calibrate_start = cycles_now();
+#elif defined (CYCLES_AVR_TIMER)
+    // Timer0 counts up to OCR0A once per ms, in CTC mode, for the ms timer.
+    cycles_rate = OCR0A + 1;
+#endif
+}
+
+void cycles_task(void) {
+#if defined (CYCLES_COUNTER)
+    // The counter runs at the core clock, measured against the ms timer.
+    if (cycles_rate == 0) {
+        const uint32_t elapsed = timer_elapsed32(cycles_calibrate_ms);
+        if (elapsed >= 1000) {
+            cycles_rate = (cycles_now() - cycles_calibrate_start) / elapsed;
+        }
+    }
+#endif
+}
+
+#if defined (CYCLES_AVR_TIMER)
+// Milliseconds and the Timer0 count within the current one.  A compare match
+// still pending means the count has wrapped but the ms has not been counted.
+uint32_t cycles_now(void) {
+    const uint8_t sreg = SREG;
+    cli();
+    uint32_t      ms    = timer_read32();
+    const uint8_t count = TCNT0;
+    if ((TIFR0 & _BV(OCF0A)) && count < OCR0A / 2) {
+        ms++;
+    }
+    SREG = sreg;
+    return ms * cycles_rate + count;
+}
+#endif
+
+uint32_t cycles_per_ms(void) {
+    return cycles_rate;
+}
+
+uint32_t cycles_to_us(uint32_t cycles) {
+    if (cycles_rate >= 1000) {
+        return cycles / (cycles_rate / 1000);
+    }
+    return cycles_rate == 0 ? 0 : cycles / cycles_rate * 1000 + cycles % cycles_rate * 1000 / cycles_rate;
+}
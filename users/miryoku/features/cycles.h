@@ -0,0 +1,43 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Timestamps for tracing and profiling, from a free-running counter with
+// sub-millisecond resolution: the core cycle counter on Cortex-M3, M4, and
+// M7, the 1 MHz system timer on RP2040, and the count of the millisecond
+// timer's Timer0 on AVR (4 us at 16 MHz).  Other MCUs have no counter,
+// cycles_per_ms() stays 0, and nothing is measured.
+
+#if defined (PROTOCOL_CHIBIOS) && (defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__))
+#    include <hal.h>
+#    define CYCLES_COUNTER
+#elif defined (MCU_RP)
+#    include "hardware/structs/timer.h"
+#    define CYCLES_RP_TIMER
+#elif defined (__AVR__)
+#    define CYCLES_AVR_TIMER
+#endif
+
+void     cycles_init(void);
+void     cycles_task(void);
+uint32_t cycles_per_ms(void); // 0 until calibrated, or without a counter
+uint32_t cycles_to_us(uint32_t cycles);
+
+#if defined (CYCLES_AVR_TIMER)
+uint32_t cycles_now(void);
+#else
+static inline uint32_t cycles_now(void) {
+#    if defined (CYCLES_COUNTER)
+    return DWT->CYCCNT;
+#    elif defined (CYCLES_RP_TIMER)
+    return timer_hw->timerawl;
+#    else
+    return 0;
+#    endif
+}
+#endif
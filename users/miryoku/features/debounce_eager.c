@@ -0,0 +1,135 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "debounce_eager.h"
+
+#include "debounce.h"
+#include "manna-harbour_miryoku.h"
+
+// Asymmetric per-key debounce: a press is reported on the first closed scan,
+// a release only once the key has read open for DEBOUNCE ms.  Release
+// countdowns are kept per key in 4 bits, two keys to a byte, so DEBOUNCE is
+// limited to 15 ms.
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE > 15
+#    error "MIRYOKU_DEBOUNCE_EAGER supports DEBOUNCE up to 15"
+#endif
+
+#define DEBOUNCE_EAGER_KEYS (MATRIX_ROWS * MATRIX_COLS)
+
+static uint8_t                debounce_eager_countdowns[(DEBOUNCE_EAGER_KEYS + 1) / 2];
+static uint16_t               debounce_eager_pending = 0; // keys with a release countdown running
+static uint16_t               debounce_eager_last    = 0;
+static debounce_eager_stats_t debounce_eager_stats;
+
+static uint8_t debounce_eager_get(uint16_t key) {
+    const uint8_t packed = debounce_eager_countdowns[key / 2];
+    return key & 1 ? packed >> 4 : packed & 0x0F;
+}
+
+static void debounce_eager_set(uint16_t key, uint8_t countdown) {
+    uint8_t *packed = &debounce_eager_countdowns[key / 2];
+    *packed         = key & 1 ? (*packed & 0x0F) | (countdown << 4) : (*packed & 0xF0) | countdown;
+}
+
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_eager_countdowns, 0, sizeof(debounce_eager_countdowns));
+    debounce_eager_pending = 0;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+#if DEBOUNCE == 0
+    if (changed) {
+        memcpy(cooked, raw, sizeof(matrix_row_t) * num_rows);
+    }
+    return changed;
+#else
+    if (!changed && debounce_eager_pending == 0) {
+        return false;
+    }
+
+    const uint16_t now     = timer_read();
+    uint16_t       elapsed = TIMER_DIFF_16(now, debounce_eager_last);
+    debounce_eager_last    = now;
+    if (elapsed > DEBOUNCE) {
+        elapsed = DEBOUNCE;
+    }
+
+    bool cooked_changed = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        const matrix_row_t delta = raw[row] ^ cooked[row];
+        if (delta == 0 && debounce_eager_pending == 0) {
+            continue;
+        }
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            const matrix_row_t bit       = (matrix_row_t)1 << col;
+            const uint16_t     key       = row * MATRIX_COLS + col;
+            const uint8_t      countdown = debounce_eager_get(key);
+
+            if (!(delta & bit)) {
+                if (countdown != 0) {
+                    // closed again before the release settled
+                    debounce_eager_set(key, 0);
+                    debounce_eager_pending--;
+                    debounce_eager_stats.chatter++;
+                }
+            } else if (raw[row] & bit) {
+                cooked[row] |= bit;
+                cooked_changed = true;
+                debounce_eager_stats.presses++;
+            } else if (countdown == 0) {
+                // new countdown; the time before this scan is not counted
+                debounce_eager_set(key, DEBOUNCE);
+                debounce_eager_pending++;
+            } else if (countdown <= elapsed) {
+                debounce_eager_set(key, 0);
+                debounce_eager_pending--;
+                cooked[row] &= ~bit;
+                cooked_changed = true;
+                debounce_eager_stats.releases++;
+            } else {
+                debounce_eager_set(key, countdown - elapsed);
+            }
+        }
+    }
+    return cooked_changed;
+#endif
+}
+
+const debounce_eager_stats_t *debounce_eager_get_stats(void) {
+    return &debounce_eager_stats;
+}
+
+void debounce_eager_clear_stats(void) {
+    memset(&debounce_eager_stats, 0, sizeof(debounce_eager_stats));
+}
+
+static void debounce_eager_put32(uint8_t *data, uint32_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+bool debounce_eager_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 15 || data[0] != U_RAW_HID_DEBOUNCE) {
+        return false;
+    }
+    if (data[1] == DEBOUNCE_EAGER_CLEAR) {
+        debounce_eager_clear_stats();
+    }
+    memset(&data[2], 0, length - 2);
+    debounce_eager_put32(&data[2], debounce_eager_stats.presses);
+    debounce_eager_put32(&data[6], debounce_eager_stats.releases);
+    debounce_eager_put32(&data[10], debounce_eager_stats.chatter);
+    data[14] = DEBOUNCE;
+    return true;
+}
@@ -0,0 +1,25 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+typedef struct {
+    uint32_t presses;  // presses reported, on the first edge
+    uint32_t releases; // releases reported, after DEBOUNCE ms stable
+    uint32_t chatter;  // releases suppressed by the key closing again in time
+} debounce_eager_stats_t;
+
+// Raw HID, U_RAW_HID_DEBOUNCE followed by one of these.  Replies echo the two
+// command bytes.  Values are little-endian.
+enum debounce_eager_commands {
+    DEBOUNCE_EAGER_GET,   // -> presses, releases, chatter (4 each), DEBOUNCE ms (1)
+    DEBOUNCE_EAGER_CLEAR, // -> as DEBOUNCE_EAGER_GET, after clearing the counts
+};
+
+const debounce_eager_stats_t *debounce_eager_get_stats(void);
+void                          debounce_eager_clear_stats(void);
+bool                          debounce_eager_raw_hid(uint8_t *data, uint8_t length);
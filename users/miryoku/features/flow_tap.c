@@ -0,0 +1,135 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow_tap.h"
+
+#include "manna-harbour_miryoku.h"
+
+// A tap-hold key pressed within the flow tap term of the previous press is
+// taken out of the tapping engine and replayed straight away as a tap.  Keys
+// are only flowed while no other tap-hold key is down, so nothing can still be
+// pending in the tapping engine and event order is kept.
+
+#define U_FLOW_TAP_SLOTS 4
+
+typedef struct {
+    keypos_t key;
+    uint16_t keycode;
+} u_flow_tap_slot_t;
+
+static u_flow_tap_slot_t u_flow_tap_slots[U_FLOW_TAP_SLOTS];
+static uint8_t           u_flow_tap_held      = 0; // tap-hold keys down and not flowed
+static uint32_t          u_flow_tap_last_time = 0;
+static bool              u_flow_tap_streak    = false;
+static flow_tap_stats_t  u_flow_tap_stats;
+
+static uint16_t u_flow_tap_term(uint16_t keycode) {
+    // LT(U_BUTTON, ...) sits on the fingers with the home row mods, the other
+    // layer-taps are the thumb keys.
+    if (IS_QK_LAYER_TAP(keycode) && QK_LAYER_TAP_GET_LAYER(keycode) != U_BUTTON) {
+        return MIRYOKU_FLOW_TAP_TERM_THUMBS;
+    }
+    return MIRYOKU_FLOW_TAP_TERM_MODS;
+}
+
+static u_flow_tap_slot_t *u_flow_tap_find(keypos_t key) {
+    for (uint8_t i = 0; i < U_FLOW_TAP_SLOTS; i++) {
+        if (u_flow_tap_slots[i].keycode != KC_NO && KEYEQ(u_flow_tap_slots[i].key, key)) {
+            return &u_flow_tap_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void u_flow_tap_replay(keyrecord_t *record) {
+    keyrecord_t tap     = *record;
+    tap.tap.count       = 1;
+    tap.tap.interrupted = false;
+    process_record(&tap);
+}
+
+bool process_flow_tap(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return true;
+    }
+
+    const bool is_tap_hold = IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+
+    if (!record->event.pressed) {
+        u_flow_tap_slot_t *slot = u_flow_tap_find(record->event.key);
+        if (slot != NULL) {
+            slot->keycode = KC_NO;
+            u_flow_tap_replay(record);
+            return false;
+        }
+        if (is_tap_hold && u_flow_tap_held > 0) {
+            u_flow_tap_held--;
+        }
+        return true;
+    }
+
+    // the event time widened to 32 bits, so long idle gaps do not wrap
+    const uint32_t time    = timer_read32() - TIMER_DIFF_16(timer_read(), record->event.time);
+    const uint32_t elapsed = time - u_flow_tap_last_time;
+    const bool     streak  = u_flow_tap_streak;
+    u_flow_tap_last_time   = time;
+    u_flow_tap_streak      = true;
+
+    if (!is_tap_hold) {
+        return true;
+    }
+    u_flow_tap_stats.presses++;
+
+    if (streak && u_flow_tap_held == 0 && elapsed < u_flow_tap_term(keycode)) {
+        u_flow_tap_slot_t *slot = NULL;
+        for (uint8_t i = 0; slot == NULL && i < U_FLOW_TAP_SLOTS; i++) {
+            if (u_flow_tap_slots[i].keycode == KC_NO) {
+                slot = &u_flow_tap_slots[i];
+            }
+        }
+        if (slot != NULL) {
+            slot->key     = record->event.key;
+            slot->keycode = keycode;
+            u_flow_tap_stats.flowed++;
+            u_flow_tap_replay(record);
+            return false;
+        }
+    }
+
+    u_flow_tap_held++;
+    return true;
+}
+
+const flow_tap_stats_t *flow_tap_get_stats(void) {
+    return &u_flow_tap_stats;
+}
+
+void flow_tap_clear_stats(void) {
+    memset(&u_flow_tap_stats, 0, sizeof(u_flow_tap_stats));
+}
+
+static void u_flow_tap_put32(uint8_t *data, uint32_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+bool flow_tap_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 14 || data[0] != U_RAW_HID_FLOW_TAP) {
+        return false;
+    }
+    if (data[1] == FLOW_TAP_CLEAR) {
+        flow_tap_clear_stats();
+    }
+    memset(&data[2], 0, length - 2);
+    u_flow_tap_put32(&data[2], u_flow_tap_stats.presses);
+    u_flow_tap_put32(&data[6], u_flow_tap_stats.flowed);
+    data[10] = MIRYOKU_FLOW_TAP_TERM_MODS;
+    data[11] = MIRYOKU_FLOW_TAP_TERM_MODS >> 8;
+    data[12] = MIRYOKU_FLOW_TAP_TERM_THUMBS;
+    data[13] = MIRYOKU_FLOW_TAP_TERM_THUMBS >> 8;
+    return true;
+}
@@ -0,0 +1,27 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+typedef struct {
+    uint32_t presses; // tap-hold presses seen
+    uint32_t flowed;  // of which resolved as taps by flow tap
+} flow_tap_stats_t;
+
+// Raw HID, U_RAW_HID_FLOW_TAP followed by one of these.  Replies echo the two
+// command bytes.  Values are little-endian.
+enum flow_tap_commands {
+    FLOW_TAP_GET,   // -> presses (4), flowed (4), mods term ms (2), thumbs term ms (2)
+    FLOW_TAP_CLEAR, // -> as FLOW_TAP_GET, after clearing the counts
+};
+
+// Called from pre_process_record_user, ahead of the tapping engine.
+bool process_flow_tap(uint16_t keycode, keyrecord_t *record);
+
+const flow_tap_stats_t *flow_tap_get_stats(void);
+void                    flow_tap_clear_stats(void);
+bool                    flow_tap_raw_hid(uint8_t *data, uint8_t length);
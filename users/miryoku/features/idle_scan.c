@@ -0,0 +1,118 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "idle_scan.h"
+
+#include "manna-harbour_miryoku.h"
+
+#if defined (MIRYOKU_SCHEDULER)
+  #include "scheduler.h"
+#endif
+
+#if defined (MIRYOKU_IDLE_SCAN)
+
+// The sleep is a wait at the end of the main loop.  On ChibiOS it suspends
+// the thread, so the core idles; on AVR it only lowers the scan rate.
+
+static idle_scan_state_t idle_scan_state = IDLE_SCAN_ACTIVE;
+static idle_scan_stats_t idle_scan_stats;
+static uint32_t          idle_scan_sleep_start = 0;
+static uint32_t          idle_scan_sleep_end   = 0;
+static bool              idle_scan_slept       = false; // no key event since the last sleep
+
+static bool idle_scan_keys_held(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void idle_scan_task(void) {
+    if (!is_keyboard_master()) {
+        // the other half answers the master from its own loop, so only the
+        // master sleeps
+        return;
+    }
+    const uint32_t idle = last_input_activity_elapsed();
+    idle_scan_state     = idle >= MIRYOKU_IDLE_SCAN_DEEP_TIMEOUT ? IDLE_SCAN_DEEP : idle >= MIRYOKU_IDLE_SCAN_TIMEOUT ? IDLE_SCAN_IDLE : IDLE_SCAN_ACTIVE;
+    if (idle_scan_state == IDLE_SCAN_ACTIVE || idle_scan_keys_held()) {
+        return;
+    }
+    uint32_t sleep = idle_scan_state == IDLE_SCAN_DEEP ? MIRYOKU_IDLE_SCAN_DEEP_INTERVAL : MIRYOKU_IDLE_SCAN_INTERVAL;
+#if defined (MIRYOKU_SCHEDULER)
+    // wake for the next feature deadline
+    const uint32_t next = scheduler_ms_until_next();
+    if (next < sleep) {
+        sleep = next;
+    }
+#endif
+    if (sleep == 0) {
+        return;
+    }
+    idle_scan_sleep_start = timer_read32();
+    wait_ms(sleep);
+    idle_scan_sleep_end = timer_read32();
+    idle_scan_slept     = true;
+    idle_scan_stats.sleeps++;
+}
+
+// Called from pre_process_record_user, so the event time is that of the scan
+// that saw the change, before the tapping engine can hold it back.
+void idle_scan_record(keyrecord_t *record) {
+    if (!idle_scan_slept || !IS_KEYEVENT(record->event)) {
+        return;
+    }
+    idle_scan_slept            = false;
+    idle_scan_state            = IDLE_SCAN_ACTIVE;
+    idle_scan_stats.wake_last  = TIMER_DIFF_16(record->event.time, (uint16_t)idle_scan_sleep_end);
+    idle_scan_stats.bound_last = TIMER_DIFF_16(record->event.time, (uint16_t)idle_scan_sleep_start);
+    if (idle_scan_stats.wake_last > idle_scan_stats.wake_max) {
+        idle_scan_stats.wake_max = idle_scan_stats.wake_last;
+    }
+    if (idle_scan_stats.bound_last > idle_scan_stats.bound_max) {
+        idle_scan_stats.bound_max = idle_scan_stats.bound_last;
+    }
+    idle_scan_stats.wakes++;
+}
+
+idle_scan_state_t idle_scan_get_state(void) {
+    return idle_scan_state;
+}
+
+const idle_scan_stats_t *idle_scan_get_stats(void) {
+    return &idle_scan_stats;
+}
+
+static void idle_scan_put16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static void idle_scan_put32(uint8_t *data, uint32_t value) {
+    idle_scan_put16(&data[0], value);
+    idle_scan_put16(&data[2], value >> 16);
+}
+
+bool idle_scan_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 19 || data[0] != U_RAW_HID_IDLE_SCAN) {
+        return false;
+    }
+    if (data[1] == IDLE_SCAN_CLEAR) {
+        memset(&idle_scan_stats, 0, sizeof(idle_scan_stats));
+    }
+    memset(&data[2], 0, length - 2);
+    data[2] = idle_scan_state;
+    idle_scan_put32(&data[3], idle_scan_stats.sleeps);
+    idle_scan_put32(&data[7], idle_scan_stats.wakes);
+    idle_scan_put16(&data[11], idle_scan_stats.wake_last);
+    idle_scan_put16(&data[13], idle_scan_stats.wake_max);
+    idle_scan_put16(&data[15], idle_scan_stats.bound_last);
+    idle_scan_put16(&data[17], idle_scan_stats.bound_max);
+    return true;
+}
+
+#endif
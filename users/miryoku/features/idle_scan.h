@@ -0,0 +1,56 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// After TIMEOUT ms without input and with no key held, each loop sleeps for
+// INTERVAL ms, and after DEEP_TIMEOUT ms for DEEP_INTERVAL ms.  The first
+// change seen by a scan brings back the full rate on the next loop.
+#ifndef MIRYOKU_IDLE_SCAN_TIMEOUT
+#    define MIRYOKU_IDLE_SCAN_TIMEOUT 5000
+#endif
+#ifndef MIRYOKU_IDLE_SCAN_INTERVAL
+#    define MIRYOKU_IDLE_SCAN_INTERVAL 5
+#endif
+#ifndef MIRYOKU_IDLE_SCAN_DEEP_TIMEOUT
+#    define MIRYOKU_IDLE_SCAN_DEEP_TIMEOUT 60000
+#endif
+#ifndef MIRYOKU_IDLE_SCAN_DEEP_INTERVAL
+#    define MIRYOKU_IDLE_SCAN_DEEP_INTERVAL 20
+#endif
+
+typedef enum {
+    IDLE_SCAN_ACTIVE,
+    IDLE_SCAN_IDLE,
+    IDLE_SCAN_DEEP,
+} idle_scan_state_t;
+
+// Latencies are of the first key event after a sleep, in ms, to the scan
+// that saw it.  wake is from the end of the sleep, the latency of the scan
+// itself.  bound is from the start of the sleep, the most the sleep can have
+// added.
+typedef struct {
+    uint32_t sleeps;
+    uint32_t wakes;
+    uint16_t wake_last;
+    uint16_t wake_max;
+    uint16_t bound_last;
+    uint16_t bound_max;
+} idle_scan_stats_t;
+
+// Raw HID, U_RAW_HID_IDLE_SCAN followed by one of these.  Replies echo the
+// two command bytes.  Values are little-endian.
+enum idle_scan_commands {
+    IDLE_SCAN_GET,   // -> state (1), sleeps (4), wakes (4), wake last, max, bound last, max (2 each)
+    IDLE_SCAN_CLEAR, // -> as IDLE_SCAN_GET, after clearing the counts
+};
+
+void                     idle_scan_task(void);
+void                     idle_scan_record(keyrecord_t *record);
+idle_scan_state_t        idle_scan_get_state(void);
+const idle_scan_stats_t *idle_scan_get_stats(void);
+bool                     idle_scan_raw_hid(uint8_t *data, uint8_t length);
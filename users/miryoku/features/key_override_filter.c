@@ -0,0 +1,65 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "key_override_filter.h"
+
+#if defined (MIRYOKU_PROFILER)
+  #include "profiler.h"
+#endif
+
+// One bit per basic keycode, set for triggers.
+static uint8_t u_kof_triggers[256 / 8];
+
+// Trigger keys down.  An override is only active while its trigger is held,
+// and the engine needs to see every key while one is, so filtering stops.
+static uint8_t u_kof_held = 0;
+
+static bool u_kof_is_trigger(uint16_t keycode) {
+    return u_kof_triggers[keycode >> 3] & (1 << (keycode & 7));
+}
+
+void key_override_filter_init(void) {
+    memset(u_kof_triggers, 0, sizeof(u_kof_triggers));
+    for (uint16_t i = 0; i < key_override_count(); i++) {
+        const key_override_t *ko = key_override_get(i);
+        if (ko == NULL) {
+            continue;
+        }
+        if (ko->trigger == KC_NO) {
+            // mods only, any key can take part
+            memset(u_kof_triggers, 0xFF, sizeof(u_kof_triggers));
+            return;
+        }
+        if (ko->trigger < 256) {
+            u_kof_triggers[ko->trigger >> 3] |= 1 << (ko->trigger & 7);
+        }
+    }
+}
+
+bool __real_process_key_override(const uint16_t keycode, const keyrecord_t *const record);
+bool __wrap_process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+    // Modifiers and non-basic keycodes, which may carry mods, always reach the engine.
+    if (IS_BASIC_KEYCODE(keycode)) {
+        if (u_kof_is_trigger(keycode)) {
+            if (record->event.pressed) {
+                if (u_kof_held < UINT8_MAX) {
+                    u_kof_held++;
+                }
+            } else if (u_kof_held > 0) {
+                u_kof_held--;
+            }
+        } else if (u_kof_held == 0) {
+            return true;
+        }
+    }
+#if defined (MIRYOKU_PROFILER)
+    const uint32_t start  = profiler_start();
+    const bool     result = __real_process_key_override(keycode, record);
+    profiler_stop(PROFILER_KEY_OVERRIDE, start);
+    return result;
+#else
+    return __real_process_key_override(keycode, record);
+#endif
+}
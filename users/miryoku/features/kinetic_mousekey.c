@@ -0,0 +1,139 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "kinetic_mousekey.h"
+
+#if defined (MIRYOKU_SCHEDULER)
+  #include "scheduler.h"
+#endif
+
+// Cursor keys are taken over from the mouse key feature.  Velocity comes from
+// the curve table by time held and is integrated over the real time since the
+// last report, with Q8 remainders carried, so motion does not depend on how
+// often reports go out.  Buttons and wheel stay with the mouse key feature.
+
+typedef struct {
+    uint16_t time;  // ms held
+    uint16_t speed; // counts per second
+} kinetic_mousekey_point_t;
+
+static const kinetic_mousekey_point_t PROGMEM kinetic_mousekey_curve[] = {MIRYOKU_KINETIC_MOUSEKEY_CURVE};
+
+#define KINETIC_MOUSEKEY_CURVE_LENGTH (sizeof(kinetic_mousekey_curve) / sizeof(kinetic_mousekey_curve[0]))
+
+enum {
+    KINETIC_MOUSEKEY_UP    = 1 << 0,
+    KINETIC_MOUSEKEY_DOWN  = 1 << 1,
+    KINETIC_MOUSEKEY_LEFT  = 1 << 2,
+    KINETIC_MOUSEKEY_RIGHT = 1 << 3,
+};
+
+static uint8_t  kinetic_mousekey_directions = 0;
+static uint32_t kinetic_mousekey_start      = 0;
+static uint32_t kinetic_mousekey_last       = 0;
+static int32_t  kinetic_mousekey_carry_x    = 0; // Q8
+static int32_t  kinetic_mousekey_carry_y    = 0;
+
+#if defined (MIRYOKU_SCHEDULER)
+static void kinetic_mousekey_timer(void) {
+    kinetic_mousekey_task();
+    if (kinetic_mousekey_directions != 0) {
+        scheduler_set(SCHEDULER_KINETIC_MOUSEKEY, kinetic_mousekey_last + MIRYOKU_KINETIC_MOUSEKEY_INTERVAL, kinetic_mousekey_timer);
+    }
+}
+#endif
+
+static uint8_t kinetic_mousekey_direction(uint16_t keycode) {
+    switch (keycode) {
+        case KC_MS_U:
+            return KINETIC_MOUSEKEY_UP;
+        case KC_MS_D:
+            return KINETIC_MOUSEKEY_DOWN;
+        case KC_MS_L:
+            return KINETIC_MOUSEKEY_LEFT;
+        case KC_MS_R:
+            return KINETIC_MOUSEKEY_RIGHT;
+        default:
+            return 0;
+    }
+}
+
+static uint32_t kinetic_mousekey_speed(uint32_t held) {
+    kinetic_mousekey_point_t low = {pgm_read_word(&kinetic_mousekey_curve[0].time), pgm_read_word(&kinetic_mousekey_curve[0].speed)};
+    for (uint8_t i = 1; i < KINETIC_MOUSEKEY_CURVE_LENGTH; i++) {
+        const kinetic_mousekey_point_t high = {pgm_read_word(&kinetic_mousekey_curve[i].time), pgm_read_word(&kinetic_mousekey_curve[i].speed)};
+        if (held < high.time) {
+            if (held <= low.time) {
+                return low.speed;
+            }
+            return low.speed + ((int32_t)high.speed - low.speed) * (int32_t)(held - low.time) / (high.time - low.time);
+        }
+        low = high;
+    }
+    return low.speed;
+}
+
+bool process_kinetic_mousekey(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t direction = kinetic_mousekey_direction(keycode);
+    if (direction == 0) {
+        return true;
+    }
+    if (record->event.pressed) {
+        if (kinetic_mousekey_directions == 0) {
+            kinetic_mousekey_start   = timer_read32();
+            kinetic_mousekey_last    = kinetic_mousekey_start;
+            kinetic_mousekey_carry_x = 0;
+            kinetic_mousekey_carry_y = 0;
+#if defined (MIRYOKU_SCHEDULER)
+            scheduler_set(SCHEDULER_KINETIC_MOUSEKEY, kinetic_mousekey_start + MIRYOKU_KINETIC_MOUSEKEY_INTERVAL, kinetic_mousekey_timer);
+#endif
+        }
+        kinetic_mousekey_directions |= direction;
+    } else {
+        kinetic_mousekey_directions &= ~direction;
+    }
+    return false;
+}
+
+static int32_t kinetic_mousekey_integrate(int8_t sign, uint32_t step_q8, int32_t *carry) {
+    const int32_t moved = *carry + sign * (int32_t)step_q8;
+    const int32_t whole = moved / 256;
+    *carry              = moved - whole * 256;
+    return whole;
+}
+
+static mouse_xy_report_t kinetic_mousekey_clamp(int32_t value) {
+    return value > XY_REPORT_MAX ? XY_REPORT_MAX : value < XY_REPORT_MIN ? XY_REPORT_MIN : (mouse_xy_report_t)value;
+}
+
+void kinetic_mousekey_task(void) {
+    if (kinetic_mousekey_directions == 0) {
+        return;
+    }
+    const uint32_t now     = timer_read32();
+    const uint32_t elapsed = TIMER_DIFF_32(now, kinetic_mousekey_last);
+    if (elapsed < MIRYOKU_KINETIC_MOUSEKEY_INTERVAL) {
+        return;
+    }
+    kinetic_mousekey_last = now;
+
+    const int8_t x = !!(kinetic_mousekey_directions & KINETIC_MOUSEKEY_RIGHT) - !!(kinetic_mousekey_directions & KINETIC_MOUSEKEY_LEFT);
+    const int8_t y = !!(kinetic_mousekey_directions & KINETIC_MOUSEKEY_DOWN) - !!(kinetic_mousekey_directions & KINETIC_MOUSEKEY_UP);
+
+    // counts/s * ms / 1000, in Q8; diagonals are scaled by 1/sqrt(2) (181/256)
+    uint32_t step_q8 = kinetic_mousekey_speed(TIMER_DIFF_32(now, kinetic_mousekey_start)) * elapsed * 256 / 1000;
+    if (x != 0 && y != 0) {
+        step_q8 = step_q8 * 181 / 256;
+    }
+
+    report_mouse_t report = mousekey_get_report();
+    report.x              = kinetic_mousekey_clamp(kinetic_mousekey_integrate(x, step_q8, &kinetic_mousekey_carry_x));
+    report.y              = kinetic_mousekey_clamp(kinetic_mousekey_integrate(y, step_q8, &kinetic_mousekey_carry_y));
+    report.v              = 0;
+    report.h              = 0;
+    if (report.x != 0 || report.y != 0) {
+        host_mouse_send(&report);
+    }
+}
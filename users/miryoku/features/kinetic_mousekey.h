@@ -0,0 +1,27 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Speed curve as {ms held, counts per second} points, ascending in time.
+// Speeds are interpolated between points and held after the last one.  The
+// default follows the stock Miryoku mouse keys: 500/s rising to 3000/s.
+#ifndef MIRYOKU_KINETIC_MOUSEKEY_CURVE
+#    define MIRYOKU_KINETIC_MOUSEKEY_CURVE {0, 500}, {250, 900}, {500, 1600}, {750, 2400}, {1000, 3000}
+#endif
+
+// Minimum ms between motion reports, the USB polling interval by default.
+#ifndef MIRYOKU_KINETIC_MOUSEKEY_INTERVAL
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define MIRYOKU_KINETIC_MOUSEKEY_INTERVAL USB_POLLING_INTERVAL_MS
+#    else
+#        define MIRYOKU_KINETIC_MOUSEKEY_INTERVAL 1
+#    endif
+#endif
+
+bool process_kinetic_mousekey(uint16_t keycode, keyrecord_t *record);
+void kinetic_mousekey_task(void);
@@ -0,0 +1,181 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "latency_trace.h"
+
+#include "cycles.h"
+#include "manna-harbour_miryoku.h"
+
+// Each key event is stamped at the three stages and the spans between them
+// binned into log2 histograms.  Stamps also go into a single producer, single
+// consumer ring buffer: the producer only advances the head and drops events
+// when full, the raw HID reader only advances the tail.
+
+#if (LATENCY_TRACE_RING_SIZE & (LATENCY_TRACE_RING_SIZE - 1)) != 0 || LATENCY_TRACE_RING_SIZE > 128
+#    error "LATENCY_TRACE_RING_SIZE must be a power of two, at most 128"
+#endif
+
+// Events between the matrix and report stages at once, e.g. held back mod-taps.
+// Events that never reach the report stage, such as keys taken by a combo,
+// leave their slot behind; when all are in use the oldest is taken over.
+#define LATENCY_TRACE_SLOTS 4
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    bool     used;
+    uint32_t matrix;
+    uint32_t resolved;
+} latency_trace_slot_t;
+
+static latency_trace_event_t latency_trace_ring[LATENCY_TRACE_RING_SIZE];
+static volatile uint8_t      latency_trace_head = 0;
+static volatile uint8_t      latency_trace_tail = 0;
+static uint32_t              latency_trace_dropped = 0;
+
+static latency_trace_slot_t latency_trace_slots[LATENCY_TRACE_SLOTS];
+static uint16_t             latency_trace_histograms[LATENCY_TRACE_SPANS][LATENCY_TRACE_BUCKETS];
+
+static void latency_trace_push(uint32_t ticks, uint8_t stage, keyrecord_t *record) {
+    const uint8_t head = latency_trace_head;
+    const uint8_t next = (head + 1) & (LATENCY_TRACE_RING_SIZE - 1);
+    if (next == latency_trace_tail) {
+        latency_trace_dropped++;
+        return;
+    }
+    latency_trace_ring[head] = (latency_trace_event_t){ticks, stage, record->event.key.row, record->event.key.col, record->event.pressed};
+    latency_trace_head       = next;
+}
+
+static void latency_trace_bin(uint8_t span, uint32_t ticks) {
+    if (cycles_per_ms() == 0) {
+        return;
+    }
+    const uint32_t us = cycles_to_us(ticks);
+    uint8_t bucket = 0;
+    for (uint32_t rest = us; rest != 0 && bucket < LATENCY_TRACE_BUCKETS - 1; rest >>= 1) {
+        bucket++;
+    }
+    if (latency_trace_histograms[span][bucket] != UINT16_MAX) {
+        latency_trace_histograms[span][bucket]++;
+    }
+}
+
+static latency_trace_slot_t *latency_trace_slot(keyrecord_t *record) {
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_trace_slot_t *slot = &latency_trace_slots[i];
+        if (slot->used && KEYEQ(slot->key, record->event.key) && slot->pressed == record->event.pressed) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+void latency_trace_record(uint8_t stage, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return;
+    }
+    const uint32_t ticks = cycles_now();
+    latency_trace_push(ticks, stage, record);
+
+    latency_trace_slot_t *slot = latency_trace_slot(record);
+    switch (stage) {
+        case LATENCY_TRACE_MATRIX:
+            if (slot == NULL) {
+                slot = &latency_trace_slots[0];
+                for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS && slot->used; i++) {
+                    latency_trace_slot_t *candidate = &latency_trace_slots[i];
+                    if (!candidate->used || ticks - candidate->matrix > ticks - slot->matrix) {
+                        slot = candidate;
+                    }
+                }
+            }
+            *slot = (latency_trace_slot_t){record->event.key, record->event.pressed, true, ticks, ticks};
+            break;
+        case LATENCY_TRACE_RESOLVED:
+            // replayed records resolve again, the last one counts
+            if (slot != NULL) {
+                slot->resolved = ticks;
+            }
+            break;
+        case LATENCY_TRACE_REPORT:
+            if (slot != NULL) {
+                latency_trace_bin(LATENCY_TRACE_SPAN_RESOLVE, slot->resolved - slot->matrix);
+                latency_trace_bin(LATENCY_TRACE_SPAN_REPORT, ticks - slot->resolved);
+                latency_trace_bin(LATENCY_TRACE_SPAN_TOTAL, ticks - slot->matrix);
+                slot->used = false;
+            }
+            break;
+        case LATENCY_TRACE_STOPPED:
+            if (slot != NULL) {
+                slot->used = false;
+            }
+            break;
+    }
+}
+
+static void latency_trace_put32(uint8_t *data, uint32_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+bool latency_trace_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 4 || data[0] != U_RAW_HID_LATENCY_TRACE) {
+        return false;
+    }
+    const uint8_t arg0  = data[2];
+    const uint8_t arg1  = data[3];
+    uint8_t      *reply = &data[2];
+    memset(reply, 0, length - 2);
+
+    switch (data[1]) {
+        case LATENCY_TRACE_INFO:
+            latency_trace_put32(&reply[0], cycles_per_ms());
+            reply[4] = (latency_trace_head - latency_trace_tail) & (LATENCY_TRACE_RING_SIZE - 1);
+            latency_trace_put32(&reply[5], latency_trace_dropped);
+            break;
+        case LATENCY_TRACE_HISTOGRAM: {
+            const uint8_t span  = arg0 < LATENCY_TRACE_SPANS ? arg0 : 0;
+            const uint8_t first = arg1 < LATENCY_TRACE_BUCKETS ? arg1 : 0;
+            uint8_t       count = (length - 5) / 2;
+            if (count > LATENCY_TRACE_BUCKETS - first) {
+                count = LATENCY_TRACE_BUCKETS - first;
+            }
+            reply[0] = span;
+            reply[1] = first;
+            reply[2] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                reply[3 + 2 * i] = latency_trace_histograms[span][first + i];
+                reply[4 + 2 * i] = latency_trace_histograms[span][first + i] >> 8;
+            }
+            break;
+        }
+        case LATENCY_TRACE_EVENTS: {
+            const uint8_t max   = (length - 3) / sizeof(latency_trace_event_t);
+            uint8_t       count = 0;
+            while (count < max && latency_trace_tail != latency_trace_head) {
+                const latency_trace_event_t *event = &latency_trace_ring[latency_trace_tail];
+                uint8_t                     *out   = &reply[1 + count * sizeof(latency_trace_event_t)];
+                latency_trace_put32(out, event->ticks);
+                out[4]             = event->stage;
+                out[5]             = event->row;
+                out[6]             = event->col;
+                out[7]             = event->pressed;
+                latency_trace_tail = (latency_trace_tail + 1) & (LATENCY_TRACE_RING_SIZE - 1);
+                count++;
+            }
+            reply[0] = count;
+            break;
+        }
+        case LATENCY_TRACE_CLEAR:
+            memset(latency_trace_histograms, 0, sizeof(latency_trace_histograms));
+            latency_trace_tail    = latency_trace_head;
+            latency_trace_dropped = 0;
+            break;
+    }
+    return true;
+}
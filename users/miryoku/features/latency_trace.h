@@ -0,0 +1,51 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Events kept for readout, a power of two.
+#ifndef LATENCY_TRACE_RING_SIZE
+#    define LATENCY_TRACE_RING_SIZE 32
+#endif
+
+// Histogram bucket 0 counts spans under 1 us, bucket i spans from 2^(i-1) up
+// to 2^i us, and the last bucket everything longer.
+#define LATENCY_TRACE_BUCKETS 20
+
+enum latency_trace_stages {
+    LATENCY_TRACE_MATRIX,   // pre_process_record_user, before tap-hold and combos
+    LATENCY_TRACE_RESOLVED, // process_record_user, after tap-hold and combos
+    LATENCY_TRACE_REPORT,   // post_process_record_user, after the HID report
+    LATENCY_TRACE_STOPPED,  // a user hook returned false, no report stage follows
+};
+
+enum latency_trace_spans {
+    LATENCY_TRACE_SPAN_RESOLVE, // matrix to resolved
+    LATENCY_TRACE_SPAN_REPORT,  // resolved to report
+    LATENCY_TRACE_SPAN_TOTAL,   // matrix to report
+    LATENCY_TRACE_SPANS,
+};
+
+typedef struct {
+    uint32_t ticks; // cycles_now(), cycles_per_ms() to the ms
+    uint8_t  stage;
+    uint8_t  row;
+    uint8_t  col;
+    uint8_t  pressed;
+} latency_trace_event_t;
+
+// Raw HID readout, U_RAW_HID_LATENCY_TRACE followed by one of these.  Replies
+// echo the two command bytes.
+enum latency_trace_commands {
+    LATENCY_TRACE_INFO,      // -> ticks per ms (u32), events buffered (u8), events dropped (u32)
+    LATENCY_TRACE_HISTOGRAM, // span, first bucket -> span, first bucket, count, buckets (u16 each)
+    LATENCY_TRACE_EVENTS,    // -> count, events (8 bytes each), removed from the buffer
+    LATENCY_TRACE_CLEAR,     // -> nothing; clears histograms, events, and drop count
+};
+
+void latency_trace_record(uint8_t stage, keyrecord_t *record);
+bool latency_trace_raw_hid(uint8_t *data, uint8_t length);
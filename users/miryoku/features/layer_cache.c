@@ -0,0 +1,75 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "layer_cache.h"
+
+// QMK walks the layer stack for the keycode, in get_event_keycode, and for
+// the action, in store_or_get_action, or layer_switch_get_action where the
+// action cache is not used.  A press walks it up to three times: twice for
+// the keycode (pre_process_record_quantum and process_record_quantum) and
+// once for the action.  Releases and the tapping engine read the source
+// layer cache instead.
+//
+// A linker wrap only redirects calls from other files, and the two action
+// lookups call layer_switch_get_layer within action_layer.c, so they are
+// wrapped themselves.
+
+#define U_LAYER_CACHE_EMPTY 0xFF
+
+static uint8_t             u_layer_cache[MATRIX_ROWS][MATRIX_COLS];
+static bool                u_layer_cache_valid = false;
+static layer_cache_stats_t u_layer_cache_stats;
+
+_Static_assert(MAX_LAYER <= U_LAYER_CACHE_EMPTY, "layer numbers must fit below the empty marker");
+
+void layer_cache_clear(void) {
+    if (u_layer_cache_valid) {
+        u_layer_cache_valid = false;
+        u_layer_cache_stats.clears++;
+    }
+}
+
+uint8_t __real_layer_switch_get_layer(keypos_t key);
+uint8_t __wrap_layer_switch_get_layer(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        // combos and encoders
+        return __real_layer_switch_get_layer(key);
+    }
+    if (!u_layer_cache_valid) {
+        memset(u_layer_cache, U_LAYER_CACHE_EMPTY, sizeof(u_layer_cache));
+        u_layer_cache_valid = true;
+    }
+    uint8_t layer = u_layer_cache[key.row][key.col];
+    if (layer == U_LAYER_CACHE_EMPTY) {
+        layer                           = __real_layer_switch_get_layer(key);
+        u_layer_cache[key.row][key.col] = layer;
+        u_layer_cache_stats.misses++;
+    } else {
+        u_layer_cache_stats.hits++;
+    }
+    return layer;
+}
+
+action_t __wrap_layer_switch_get_action(keypos_t key) {
+    return action_for_key(__wrap_layer_switch_get_layer(key), key);
+}
+
+action_t __real_store_or_get_action(bool pressed, keypos_t key);
+action_t __wrap_store_or_get_action(bool pressed, keypos_t key) {
+#if !defined (NO_ACTION_LAYER) && !defined (STRICT_LAYER_RELEASE)
+    if (!pressed || disable_action_cache) {
+        return __real_store_or_get_action(pressed, key);
+    }
+    const uint8_t layer = __wrap_layer_switch_get_layer(key);
+    update_source_layers_cache(key, layer);
+    return action_for_key(layer, key);
+#else
+    return __wrap_layer_switch_get_action(key);
+#endif
+}
+
+const layer_cache_stats_t *layer_cache_get_stats(void) {
+    return &u_layer_cache_stats;
+}
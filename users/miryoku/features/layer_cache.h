@@ -0,0 +1,23 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// The layer each matrix position resolves to, the highest active layer where
+// it is not transparent, is cached until the layer state changes.  Clear it
+// on layer state changes, from the layer_state_set hooks, and after changing
+// the keymap itself.
+void layer_cache_clear(void);
+
+// Each hit is one layer stack walk saved.
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t clears;
+} layer_cache_stats_t;
+
+const layer_cache_stats_t *layer_cache_get_stats(void);
@@ -0,0 +1,227 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "maccel_fixed.h"
+
+#include <math.h>
+
+#include "manna-harbour_miryoku.h"
+
+// Fixed-point maccel.  The curve
+//   f(v) = 1 - (1 - M) / (1 + e^(K(v - S)))^(G/K)
+// is only evaluated in float when the table is rebuilt, i.e. at init and when
+// a parameter changes.  Each motion report is integer only, unless the table
+// is out of tolerance for the parameters, in which case the float curve is
+// evaluated per report instead.
+
+// fine entries every 1/4 count/ms, then coarse entries every count/ms
+#define MACCEL_FIXED_FINE    (MACCEL_FIXED_FINE_MAX * 4)
+#define MACCEL_FIXED_ENTRIES (MACCEL_FIXED_FINE + MACCEL_FIXED_VELOCITY_MAX - MACCEL_FIXED_FINE_MAX + 1)
+
+_Static_assert(MACCEL_FIXED_ENTRIES <= UINT8_MAX, "maccel fixed table too long");
+
+static uint16_t maccel_fixed_table[MACCEL_FIXED_ENTRIES];
+static uint16_t maccel_fixed_max_error = 0;
+static bool     maccel_fixed_ready     = false;
+static bool     maccel_fixed_float     = false;
+static float    maccel_fixed_params[4];
+
+// Motion is accumulated rather than rounded or clamped per report: the Q8
+// carry keeps sub-count remainders, and whole counts beyond the report range
+// stay pending and are sent in the following reports.
+static int32_t  maccel_fixed_carry_x   = 0; // Q8
+static int32_t  maccel_fixed_carry_y   = 0;
+static int32_t  maccel_fixed_pending_x = 0; // whole counts
+static int32_t  maccel_fixed_pending_y = 0;
+static uint32_t maccel_fixed_timer     = 0;
+
+static maccel_fixed_stats_t maccel_fixed_stats;
+
+static float maccel_fixed_curve(float v, float k, float g, float s, float m) {
+    return 1.0f - (1.0f - m) / powf(1.0f + expf(k * (v - s)), g / k);
+}
+
+// velocity of a table entry, Q4 counts/ms
+static uint16_t maccel_fixed_knot(uint8_t index) {
+    if (index < MACCEL_FIXED_FINE) {
+        return index << 2;
+    }
+    return (MACCEL_FIXED_FINE_MAX << 4) + ((index - MACCEL_FIXED_FINE) << 4);
+}
+
+void maccel_fixed_set_params(float takeoff, float growth_rate, float offset, float limit) {
+    const float scale = (float)(1 << MACCEL_FIXED_SHIFT);
+    maccel_fixed_params[0] = takeoff;
+    maccel_fixed_params[1] = growth_rate;
+    maccel_fixed_params[2] = offset;
+    maccel_fixed_params[3] = limit;
+    for (uint8_t i = 0; i < MACCEL_FIXED_ENTRIES; i++) {
+        maccel_fixed_table[i] = (uint16_t)lroundf(maccel_fixed_curve(maccel_fixed_knot(i) / 16.0f, takeoff, growth_rate, offset, limit) * scale);
+    }
+    // Worst case interpolation error is near the middle of an interval.
+    maccel_fixed_max_error = 0;
+    for (uint8_t i = 0; i + 1 < MACCEL_FIXED_ENTRIES; i++) {
+        const float    middle = (maccel_fixed_knot(i) + maccel_fixed_knot(i + 1)) / 32.0f;
+        const float    exact  = maccel_fixed_curve(middle, takeoff, growth_rate, offset, limit) * scale;
+        const uint16_t error  = (uint16_t)lroundf(fabsf(exact - (maccel_fixed_table[i] + maccel_fixed_table[i + 1]) / 2.0f));
+        if (error > maccel_fixed_max_error) {
+            maccel_fixed_max_error = error;
+        }
+    }
+    maccel_fixed_float = maccel_fixed_max_error > MACCEL_FIXED_TOLERANCE;
+    maccel_fixed_ready = true;
+}
+
+void maccel_fixed_init(void) {
+    maccel_fixed_set_params(MACCEL_TAKEOFF, MACCEL_GROWTH_RATE, MACCEL_OFFSET, MACCEL_LIMIT);
+}
+
+uint16_t maccel_fixed_error(void) {
+    return maccel_fixed_max_error;
+}
+
+bool maccel_fixed_is_float(void) {
+    return maccel_fixed_float;
+}
+
+uint16_t maccel_fixed_factor(uint16_t velocity_q4) {
+    if (maccel_fixed_float) {
+        const float factor = maccel_fixed_curve(velocity_q4 / 16.0f, maccel_fixed_params[0], maccel_fixed_params[1], maccel_fixed_params[2], maccel_fixed_params[3]);
+        return (uint16_t)lroundf(factor * (1 << MACCEL_FIXED_SHIFT));
+    }
+    uint16_t index;
+    uint8_t  fraction;
+    uint8_t  shift;
+    if (velocity_q4 < (MACCEL_FIXED_FINE_MAX << 4)) {
+        index    = velocity_q4 >> 2;
+        fraction = velocity_q4 & 0x3;
+        shift    = 2;
+    } else {
+        const uint16_t coarse = velocity_q4 - (MACCEL_FIXED_FINE_MAX << 4);
+        index                 = MACCEL_FIXED_FINE + (coarse >> 4);
+        fraction              = coarse & 0xF;
+        shift                 = 4;
+    }
+    if (index >= MACCEL_FIXED_ENTRIES - 1) {
+        return maccel_fixed_table[MACCEL_FIXED_ENTRIES - 1];
+    }
+    const int32_t low  = maccel_fixed_table[index];
+    const int32_t high = maccel_fixed_table[index + 1];
+    return (uint16_t)(low + (((high - low) * fraction) >> shift));
+}
+
+static uint32_t maccel_fixed_isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit  = 1UL << 30;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static int32_t maccel_fixed_scale(mouse_xy_report_t value, uint16_t factor, int32_t *carry) {
+    const int32_t scaled = (((int32_t)value * factor) >> (MACCEL_FIXED_SHIFT - 8)) + *carry;
+    const int32_t result = scaled >> 8;
+    *carry               = scaled - (result << 8);
+    return result;
+}
+
+static mouse_xy_report_t maccel_fixed_emit(int32_t *pending) {
+    int32_t result = *pending;
+    if (result > XY_REPORT_MAX) {
+        result = XY_REPORT_MAX;
+    } else if (result < XY_REPORT_MIN) {
+        result = XY_REPORT_MIN;
+    }
+    *pending -= result;
+    if (*pending != 0) {
+        maccel_fixed_stats.split++;
+        if (*pending > MACCEL_FIXED_PENDING_MAX) {
+            maccel_fixed_stats.dropped += *pending - MACCEL_FIXED_PENDING_MAX;
+            *pending = MACCEL_FIXED_PENDING_MAX;
+        } else if (*pending < -MACCEL_FIXED_PENDING_MAX) {
+            maccel_fixed_stats.dropped += -MACCEL_FIXED_PENDING_MAX - *pending;
+            *pending = -MACCEL_FIXED_PENDING_MAX;
+        }
+    }
+    return (mouse_xy_report_t)result;
+}
+
+const maccel_fixed_stats_t *maccel_fixed_get_stats(void) {
+    return &maccel_fixed_stats;
+}
+
+report_mouse_t pointing_device_task_maccel_fixed(report_mouse_t mouse_report) {
+    if (mouse_report.x == 0 && mouse_report.y == 0) {
+        if (maccel_fixed_pending_x != 0 || maccel_fixed_pending_y != 0) {
+            mouse_report.x = maccel_fixed_emit(&maccel_fixed_pending_x);
+            mouse_report.y = maccel_fixed_emit(&maccel_fixed_pending_y);
+        }
+        return mouse_report;
+    }
+    if (!maccel_fixed_ready) {
+        maccel_fixed_init();
+    }
+    maccel_fixed_stats.reports++;
+
+    uint32_t delta_time = timer_elapsed32(maccel_fixed_timer);
+    maccel_fixed_timer  = timer_read32();
+    if (delta_time > MACCEL_ROUNDING_CARRY_TIMEOUT_MS) {
+        maccel_fixed_carry_x = 0;
+        maccel_fixed_carry_y = 0;
+    }
+    if (delta_time == 0) {
+        delta_time = 1;
+    }
+
+    // Distance in Q4 counts, velocity in Q4 counts/ms corrected to 1000 DPI.
+    const int32_t  x           = mouse_report.x;
+    const int32_t  y           = mouse_report.y;
+    const uint32_t squared     = (uint32_t)(x * x) + (uint32_t)(y * y);
+    const uint32_t distance_q4 = squared < (1UL << 24) ? maccel_fixed_isqrt(squared << 8) : maccel_fixed_isqrt(squared) << 4;
+    uint16_t       cpi         = pointing_device_get_cpi();
+    if (cpi == 0) {
+        cpi = 1000;
+    }
+    const uint32_t velocity_q4 = distance_q4 * 1000UL / ((uint32_t)cpi * delta_time);
+    const uint16_t factor      = maccel_fixed_factor(velocity_q4 > UINT16_MAX ? UINT16_MAX : velocity_q4);
+
+    maccel_fixed_pending_x += maccel_fixed_scale(mouse_report.x, factor, &maccel_fixed_carry_x);
+    maccel_fixed_pending_y += maccel_fixed_scale(mouse_report.y, factor, &maccel_fixed_carry_y);
+    mouse_report.x = maccel_fixed_emit(&maccel_fixed_pending_x);
+    mouse_report.y = maccel_fixed_emit(&maccel_fixed_pending_y);
+    return mouse_report;
+}
+
+static void maccel_fixed_put(uint8_t *data, uint32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        data[i] = value >> (i * 8);
+    }
+}
+
+bool maccel_fixed_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 19 || data[0] != U_RAW_HID_MACCEL) {
+        return false;
+    }
+    memset(&data[2], 0, length - 2);
+    if (data[1] == MACCEL_FIXED_GET) {
+        maccel_fixed_put(&data[2], maccel_fixed_max_error, 2);
+        maccel_fixed_put(&data[4], MACCEL_FIXED_TOLERANCE, 2);
+        data[6] = maccel_fixed_float;
+        maccel_fixed_put(&data[7], maccel_fixed_stats.reports, 4);
+        maccel_fixed_put(&data[11], maccel_fixed_stats.split, 4);
+        maccel_fixed_put(&data[15], maccel_fixed_stats.dropped, 4);
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Same curve parameters and defaults as maccel.
+#ifndef MACCEL_TAKEOFF
+#    define MACCEL_TAKEOFF 2.0
+#endif
+#ifndef MACCEL_GROWTH_RATE
+#    define MACCEL_GROWTH_RATE 0.25
+#endif
+#ifndef MACCEL_OFFSET
+#    define MACCEL_OFFSET 2.2
+#endif
+#ifndef MACCEL_LIMIT
+#    define MACCEL_LIMIT 0.2
+#endif
+#ifndef MACCEL_ROUNDING_CARRY_TIMEOUT_MS
+#    define MACCEL_ROUNDING_CARRY_TIMEOUT_MS 200
+#endif
+
+// Acceleration factors are Q4.12, velocities are counts/ms at 1000 DPI.  The
+// table has four entries per count/ms up to FINE_MAX, where the curve takes
+// off, and one entry per count/ms from there to VELOCITY_MAX.  It is linearly
+// interpolated; velocities past the end use the last entry.
+#define MACCEL_FIXED_SHIFT 12
+#ifndef MACCEL_FIXED_VELOCITY_MAX
+#    define MACCEL_FIXED_VELOCITY_MAX 64
+#endif
+#ifndef MACCEL_FIXED_FINE_MAX
+#    define MACCEL_FIXED_FINE_MAX 16
+#endif
+
+_Static_assert(MACCEL_FIXED_FINE_MAX <= MACCEL_FIXED_VELOCITY_MAX, "maccel fixed fine table past the velocity max");
+// Maximum interpolation error against the float curve, Q4.12 (~0.5%).  Past
+// it the table is not used and the float curve is evaluated per report.
+#ifndef MACCEL_FIXED_TOLERANCE
+#    define MACCEL_FIXED_TOLERANCE 20
+#endif
+
+// Whole counts that may wait for later reports before motion is dropped.
+#ifndef MACCEL_FIXED_PENDING_MAX
+#    define MACCEL_FIXED_PENDING_MAX (4L * XY_REPORT_MAX)
+#endif
+
+typedef struct {
+    uint32_t reports; // motion reports accelerated
+    uint32_t split;   // axis values that left motion pending for the next report
+    uint32_t dropped; // counts beyond MACCEL_FIXED_PENDING_MAX, lost
+} maccel_fixed_stats_t;
+
+// Raw HID, U_RAW_HID_MACCEL followed by one of these.  Replies echo the two
+// command bytes.  Values are little-endian.
+enum maccel_fixed_commands {
+    MACCEL_FIXED_GET, // -> table error (2), tolerance (2), float fallback (1), reports (4), split (4), dropped (4)
+};
+
+void           maccel_fixed_init(void);
+void           maccel_fixed_set_params(float takeoff, float growth_rate, float offset, float limit);
+uint16_t       maccel_fixed_factor(uint16_t velocity_q4);
+uint16_t       maccel_fixed_error(void);
+bool           maccel_fixed_is_float(void);
+bool           maccel_fixed_raw_hid(uint8_t *data, uint8_t length);
+
+const maccel_fixed_stats_t *maccel_fixed_get_stats(void);
+
+report_mouse_t pointing_device_task_maccel_fixed(report_mouse_t mouse_report);
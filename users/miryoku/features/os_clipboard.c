@@ -0,0 +1,59 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "os_clipboard.h"
+
+#include "manna-harbour_miryoku.h"
+
+// U_RDO, U_PST, U_CPY, U_CUT, and U_UND are custom keycodes, resolved on
+// press through a style by action table.  The keycode registered is kept per
+// action so that the release matches even if the style changed in between.
+
+#define U_CLIPBOARD_ACTIONS (U_CLIP_UND - U_CLIP_RDO + 1)
+
+static const uint16_t PROGMEM os_clipboard_keycodes[U_CLIPBOARD_STYLES][U_CLIPBOARD_ACTIONS] = {
+    [U_CLIPBOARD_DEFAULT] = {KC_AGIN, S(KC_INS), C(KC_INS), S(KC_DEL), KC_UNDO},
+    [U_CLIPBOARD_FUN]     = {KC_AGIN, KC_PSTE, KC_COPY, KC_CUT, KC_UNDO},
+    [U_CLIPBOARD_MAC]     = {SCMD(KC_Z), LCMD(KC_V), LCMD(KC_C), LCMD(KC_X), LCMD(KC_Z)},
+    [U_CLIPBOARD_WIN]     = {C(KC_Y), C(KC_V), C(KC_C), C(KC_X), C(KC_Z)},
+};
+
+static uint16_t os_clipboard_pressed[U_CLIPBOARD_ACTIONS];
+
+uint8_t os_clipboard_style(void) {
+    if (miryoku_config.clipboard != U_CLIPBOARD_AUTO && miryoku_config.clipboard < U_CLIPBOARD_STYLES) {
+        return miryoku_config.clipboard;
+    }
+    switch (detected_host_os()) {
+        case OS_MACOS:
+        case OS_IOS:
+            return U_CLIPBOARD_MAC;
+        case OS_WINDOWS:
+            return U_CLIPBOARD_WIN;
+        default:
+            return U_CLIPBOARD_DEFAULT;
+    }
+}
+
+bool process_os_clipboard(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == U_CLIPBOARD_NEXT) {
+        if (record->event.pressed) {
+            miryoku_config.clipboard = (miryoku_config.clipboard + 1) % U_CLIPBOARD_STYLES;
+            eeconfig_update_user(miryoku_config.raw);
+        }
+        return false;
+    }
+    if (keycode < U_CLIP_RDO || keycode > U_CLIP_UND) {
+        return true;
+    }
+    const uint8_t action = keycode - U_CLIP_RDO;
+    if (record->event.pressed) {
+        os_clipboard_pressed[action] = pgm_read_word(&os_clipboard_keycodes[os_clipboard_style()][action]);
+        register_code16(os_clipboard_pressed[action]);
+    } else {
+        unregister_code16(os_clipboard_pressed[action]);
+    }
+    return false;
+}
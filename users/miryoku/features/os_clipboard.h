@@ -0,0 +1,23 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Clipboard key styles, as the compile-time MIRYOKU_CLIPBOARD options.
+// miryoku_config.clipboard holds U_CLIPBOARD_AUTO to follow the detected host
+// OS, or a style to use regardless.
+enum os_clipboard_styles {
+    U_CLIPBOARD_AUTO,
+    U_CLIPBOARD_DEFAULT, // Linux and unknown hosts
+    U_CLIPBOARD_FUN,
+    U_CLIPBOARD_MAC,
+    U_CLIPBOARD_WIN,
+    U_CLIPBOARD_STYLES,
+};
+
+uint8_t os_clipboard_style(void);
+bool    process_os_clipboard(uint16_t keycode, keyrecord_t *record);
@@ -0,0 +1,173 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "profiler.h"
+
+#include "cycles.h"
+#include "manna-harbour_miryoku.h"
+
+// QMK functions are timed through linker wraps (-Wl,--wrap=, see
+// post_rules.mk): calls from other translation units reach __wrap_X, which
+// times __real_X.
+
+static profiler_section_t profiler_sections[PROFILER_SECTIONS];
+static bool               profiler_sampling = true;
+static uint8_t            profiler_loops    = 0;
+static uint32_t           profiler_loop     = 0;
+
+static void profiler_add(uint8_t section, uint32_t cycles) {
+    if (cycles_per_ms() == 0) {
+        return;
+    }
+    profiler_section_t *stats = &profiler_sections[section];
+    const uint32_t      us    = cycles_to_us(cycles);
+
+    if (stats->count == 0 || us < stats->min) {
+        stats->min = us;
+    }
+    if (us > stats->max) {
+        stats->max = us;
+    }
+    stats->count++;
+    stats->sum += us;
+
+    uint8_t bucket = 0;
+    for (uint32_t rest = us; rest != 0 && bucket < PROFILER_BUCKETS - 1; rest >>= 1) {
+        bucket++;
+    }
+    if (stats->histogram[bucket] != UINT16_MAX) {
+        stats->histogram[bucket]++;
+    }
+}
+
+uint32_t profiler_start(void) {
+    return profiler_sampling ? cycles_now() : 0;
+}
+
+void profiler_stop(uint8_t section, uint32_t start) {
+    if (profiler_sampling) {
+        profiler_add(section, cycles_now() - start);
+    }
+}
+
+void profiler_task(void) {
+    const uint32_t now = cycles_now();
+    if (profiler_loop != 0) {
+        profiler_add(PROFILER_LOOP, now - profiler_loop);
+    }
+    profiler_loop     = now;
+    profiler_loops    = (profiler_loops + 1) & ((1 << MIRYOKU_PROFILER_SAMPLE_SHIFT) - 1);
+    profiler_sampling = profiler_loops == 0;
+}
+
+const profiler_section_t *profiler_get_section(uint8_t section) {
+    return section < PROFILER_SECTIONS ? &profiler_sections[section] : NULL;
+}
+
+static void profiler_put32(uint8_t *data, uint32_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+bool profiler_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 3 || data[0] != U_RAW_HID_PROFILER) {
+        return false;
+    }
+    const uint8_t             section = data[2] < PROFILER_SECTIONS ? data[2] : PROFILER_LOOP;
+    const profiler_section_t *stats   = &profiler_sections[section];
+    uint8_t                  *reply   = &data[2];
+    memset(reply, 0, length - 2);
+
+    switch (data[1]) {
+        case PROFILER_STATS:
+            reply[0] = section;
+            profiler_put32(&reply[1], stats->count);
+            profiler_put32(&reply[5], stats->min);
+            profiler_put32(&reply[9], stats->count ? stats->sum / stats->count : 0);
+            profiler_put32(&reply[13], stats->max);
+            break;
+        case PROFILER_HISTOGRAM:
+            reply[0] = section;
+            for (uint8_t i = 0; i < PROFILER_BUCKETS && 2 + 2 * i < length - 2; i++) {
+                reply[1 + 2 * i] = stats->histogram[i];
+                reply[2 + 2 * i] = stats->histogram[i] >> 8;
+            }
+            break;
+        case PROFILER_CLEAR:
+            memset(profiler_sections, 0, sizeof(profiler_sections));
+            break;
+        case PROFILER_INFO:
+            profiler_put32(&reply[0], cycles_per_ms());
+            break;
+    }
+    return true;
+}
+
+// wrapped QMK functions
+
+uint8_t __real_matrix_scan(void);
+uint8_t __wrap_matrix_scan(void) {
+    const uint32_t start  = profiler_start();
+    const uint8_t  result = __real_matrix_scan();
+    profiler_stop(PROFILER_MATRIX, start);
+    return result;
+}
+
+#if defined (COMBO_ENABLE)
+bool __real_process_combo(uint16_t keycode, keyrecord_t *record);
+bool __wrap_process_combo(uint16_t keycode, keyrecord_t *record) {
+    const uint32_t start  = profiler_start();
+    const bool     result = __real_process_combo(keycode, record);
+    profiler_stop(PROFILER_COMBO, start);
+    return result;
+}
+
+void __real_combo_task(void);
+void __wrap_combo_task(void) {
+    const uint32_t start = profiler_start();
+    __real_combo_task();
+    profiler_stop(PROFILER_COMBO, start);
+}
+#endif
+
+#if defined (TAP_DANCE_ENABLE)
+bool __real_process_tap_dance(uint16_t keycode, keyrecord_t *record);
+bool __wrap_process_tap_dance(uint16_t keycode, keyrecord_t *record) {
+    const uint32_t start  = profiler_start();
+    const bool     result = __real_process_tap_dance(keycode, record);
+    profiler_stop(PROFILER_TAP_DANCE, start);
+    return result;
+}
+
+void __real_tap_dance_task(void);
+void __wrap_tap_dance_task(void) {
+    const uint32_t start = profiler_start();
+    __real_tap_dance_task();
+    profiler_stop(PROFILER_TAP_DANCE, start);
+}
+#endif
+
+// timed by the key override filter when it wraps the engine
+#if defined (KEY_OVERRIDE_ENABLE) && !defined (MIRYOKU_KEY_OVERRIDE_FILTER)
+bool __real_process_key_override(const uint16_t keycode, const keyrecord_t *const record);
+bool __wrap_process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+    const uint32_t start  = profiler_start();
+    const bool     result = __real_process_key_override(keycode, record);
+    profiler_stop(PROFILER_KEY_OVERRIDE, start);
+    return result;
+}
+#endif
+
+#if defined (SPLIT_KEYBOARD)
+bool __real_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+bool __wrap_transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    const uint32_t start  = profiler_start();
+    const bool     result = __real_transport_master(master_matrix, slave_matrix);
+    profiler_stop(PROFILER_SPLIT, start);
+    return result;
+}
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Sections are timed on one loop in 2^MIRYOKU_PROFILER_SAMPLE_SHIFT.  The
+// loop itself is always timed.
+#ifndef MIRYOKU_PROFILER_SAMPLE_SHIFT
+#    define MIRYOKU_PROFILER_SAMPLE_SHIFT 0
+#endif
+
+// Histogram bucket 0 counts times under 1 us, bucket i times from 2^(i-1) up
+// to 2^i us, and the last bucket everything longer.
+#define PROFILER_BUCKETS 16
+
+enum profiler_sections {
+    PROFILER_LOOP,         // housekeeping to housekeeping, the scan period
+    PROFILER_MATRIX,       // matrix_scan, including the split transaction
+    PROFILER_POINTING,     // pointing_device_task_user, maccel and smooth scroll
+    PROFILER_COMBO,        // process_combo and combo_task
+    PROFILER_TAP_DANCE,    // process_tap_dance and tap_dance_task
+    PROFILER_KEY_OVERRIDE, // process_key_override
+    PROFILER_SPLIT,        // transport_master
+    PROFILER_HOUSEKEEPING, // housekeeping_task_user, the polled feature tasks
+    PROFILER_SECTIONS,
+};
+
+typedef struct {
+    uint32_t count;
+    uint32_t min; // us
+    uint32_t max; // us
+    uint32_t sum; // us
+    uint16_t histogram[PROFILER_BUCKETS];
+} profiler_section_t;
+
+// Raw HID readout, U_RAW_HID_PROFILER followed by one of these.  Replies echo
+// the two command bytes.
+enum profiler_commands {
+    PROFILER_STATS,     // section -> section, count, min, avg, max (u32 each, us)
+    PROFILER_HISTOGRAM, // section -> section, buckets (u16 each)
+    PROFILER_CLEAR,     // -> nothing; clears all sections
+    PROFILER_INFO,      // -> counter ticks per ms (u32), 0 if the MCU has no counter
+};
+
+uint32_t profiler_start(void);
+void     profiler_stop(uint8_t section, uint32_t start);
+void     profiler_task(void);
+bool     profiler_raw_hid(uint8_t *data, uint8_t length);
+
+const profiler_section_t *profiler_get_section(uint8_t section);
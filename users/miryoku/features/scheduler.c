@@ -0,0 +1,129 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "scheduler.h"
+
+#define SCHEDULER_IDLE 0xFF
+
+static uint32_t             scheduler_deadlines[SCHEDULER_TIMERS];
+static scheduler_callback_t scheduler_callbacks[SCHEDULER_TIMERS];
+static uint8_t              scheduler_heap[SCHEDULER_TIMERS]; // timers, earliest deadline first
+static uint8_t              scheduler_slots[SCHEDULER_TIMERS] = {[0 ... SCHEDULER_TIMERS - 1] = SCHEDULER_IDLE}; // heap index of each timer
+static uint8_t              scheduler_size = 0;
+
+// deadline order, valid across timer wraparound
+static bool scheduler_before(uint8_t a, uint8_t b) {
+    return (int32_t)(scheduler_deadlines[a] - scheduler_deadlines[b]) < 0;
+}
+
+static void scheduler_place(uint8_t index, uint8_t timer) {
+    scheduler_heap[index]  = timer;
+    scheduler_slots[timer] = index;
+}
+
+static void scheduler_sift_up(uint8_t index) {
+    const uint8_t timer = scheduler_heap[index];
+    while (index > 0) {
+        const uint8_t parent = (index - 1) / 2;
+        if (!scheduler_before(timer, scheduler_heap[parent])) {
+            break;
+        }
+        scheduler_place(index, scheduler_heap[parent]);
+        index = parent;
+    }
+    scheduler_place(index, timer);
+}
+
+static void scheduler_sift_down(uint8_t index) {
+    const uint8_t timer = scheduler_heap[index];
+    for (;;) {
+        uint8_t child = index * 2 + 1;
+        if (child >= scheduler_size) {
+            break;
+        }
+        if (child + 1 < scheduler_size && scheduler_before(scheduler_heap[child + 1], scheduler_heap[child])) {
+            child++;
+        }
+        if (!scheduler_before(scheduler_heap[child], timer)) {
+            break;
+        }
+        scheduler_place(index, scheduler_heap[child]);
+        index = child;
+    }
+    scheduler_place(index, timer);
+}
+
+static void scheduler_remove(uint8_t timer) {
+    const uint8_t index    = scheduler_slots[timer];
+    scheduler_slots[timer] = SCHEDULER_IDLE;
+    scheduler_size--;
+    if (index == scheduler_size) {
+        return;
+    }
+    scheduler_place(index, scheduler_heap[scheduler_size]);
+    if (index > 0 && scheduler_before(scheduler_heap[index], scheduler_heap[(index - 1) / 2])) {
+        scheduler_sift_up(index);
+    } else {
+        scheduler_sift_down(index);
+    }
+}
+
+void scheduler_set(uint8_t timer, uint32_t deadline, scheduler_callback_t callback) {
+    if (timer >= SCHEDULER_TIMERS) {
+        return;
+    }
+    scheduler_callbacks[timer] = callback;
+    if (scheduler_slots[timer] != SCHEDULER_IDLE) {
+        const bool earlier         = (int32_t)(deadline - scheduler_deadlines[timer]) < 0;
+        scheduler_deadlines[timer] = deadline;
+        if (earlier) {
+            scheduler_sift_up(scheduler_slots[timer]);
+        } else {
+            scheduler_sift_down(scheduler_slots[timer]);
+        }
+        return;
+    }
+    scheduler_deadlines[timer] = deadline;
+    scheduler_place(scheduler_size, timer);
+    scheduler_sift_up(scheduler_size++);
+}
+
+void scheduler_cancel(uint8_t timer) {
+    if (timer < SCHEDULER_TIMERS && scheduler_slots[timer] != SCHEDULER_IDLE) {
+        scheduler_remove(timer);
+    }
+}
+
+bool scheduler_pending(uint8_t timer) {
+    return timer < SCHEDULER_TIMERS && scheduler_slots[timer] != SCHEDULER_IDLE;
+}
+
+uint32_t scheduler_ms_until_next(void) {
+    if (scheduler_size == 0) {
+        return UINT32_MAX;
+    }
+    const int32_t remaining = scheduler_deadlines[scheduler_heap[0]] - timer_read32();
+    return remaining > 0 ? remaining : 0;
+}
+
+void scheduler_task(void) {
+    if (scheduler_size == 0) {
+        return;
+    }
+    // Due timers are all taken off before any callback runs, so a callback
+    // setting its timer again, even at now, waits for the next call.
+    const uint32_t       now = timer_read32();
+    scheduler_callback_t due[SCHEDULER_TIMERS];
+    uint8_t              count = 0;
+    while (scheduler_size > 0 && (int32_t)(now - scheduler_deadlines[scheduler_heap[0]]) >= 0) {
+        due[count++] = scheduler_callbacks[scheduler_heap[0]];
+        scheduler_remove(scheduler_heap[0]);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (due[i] != NULL) {
+            due[i]();
+        }
+    }
+}
@@ -0,0 +1,32 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// One timer per feature, each either pending at a deadline or idle.  Pending
+// timers are kept in a min-heap, so scheduler_task only compares the earliest
+// deadline with the time until something is due.
+enum scheduler_timers {
+    SCHEDULER_BILATERAL_COMBINATIONS, // tapping term of a held back tap-hold key
+    SCHEDULER_KINETIC_MOUSEKEY,       // next cursor report
+    SCHEDULER_AUTO_SHIFT_ADAPT,       // next chance to save learned timeouts
+    SCHEDULER_TIMERS,
+};
+
+typedef void (*scheduler_callback_t)(void);
+
+// Deadlines are timer_read32() times, within 2^31 ms of now.  Setting a
+// pending timer moves it.  Callbacks run from scheduler_task, after their
+// timer is idle again, and may set it again.
+void scheduler_set(uint8_t timer, uint32_t deadline, scheduler_callback_t callback);
+void scheduler_cancel(uint8_t timer);
+bool scheduler_pending(uint8_t timer);
+
+// ms until the earliest deadline, 0 if one is due, UINT32_MAX if none is set.
+uint32_t scheduler_ms_until_next(void);
+
+void scheduler_task(void);
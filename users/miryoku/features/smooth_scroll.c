@@ -0,0 +1,172 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "smooth_scroll.h"
+
+// Wheel keys and drag scroll are both accumulated in Q8 fractions of a
+// high-resolution wheel unit (1 / pointing_device_get_hires_scroll_resolution()
+// of a detent), and only whole units are sent.  Remainders are carried to the
+// next report and cleared when scrolling stops.
+
+typedef struct {
+    uint16_t in;
+    uint16_t out;
+} smooth_scroll_point_t;
+
+static const smooth_scroll_point_t PROGMEM smooth_scroll_wheel_curve[] = {MIRYOKU_SMOOTH_SCROLL_WHEEL_CURVE};
+static const smooth_scroll_point_t PROGMEM smooth_scroll_drag_curve[]  = {MIRYOKU_SMOOTH_SCROLL_DRAG_CURVE};
+
+#define SMOOTH_SCROLL_CURVE_LENGTH(curve) (sizeof(curve) / sizeof(curve[0]))
+
+// Longest gap between reports integrated for wheel keys, bounds the arithmetic.
+#define SMOOTH_SCROLL_ELAPSED_MAX 100
+
+enum {
+    SMOOTH_SCROLL_UP    = 1 << 0,
+    SMOOTH_SCROLL_DOWN  = 1 << 1,
+    SMOOTH_SCROLL_LEFT  = 1 << 2,
+    SMOOTH_SCROLL_RIGHT = 1 << 3,
+};
+
+static uint8_t  smooth_scroll_directions = 0;
+static bool     smooth_scroll_dragging   = false;
+static uint32_t smooth_scroll_start      = 0;
+static uint32_t smooth_scroll_last       = 0;
+static int32_t  smooth_scroll_carry_v    = 0; // Q8 high-resolution units
+static int32_t  smooth_scroll_carry_h    = 0;
+
+static uint16_t smooth_scroll_interpolate(const smooth_scroll_point_t *curve, uint8_t length, uint32_t in) {
+    smooth_scroll_point_t low = {pgm_read_word(&curve[0].in), pgm_read_word(&curve[0].out)};
+    for (uint8_t i = 1; i < length; i++) {
+        const smooth_scroll_point_t high = {pgm_read_word(&curve[i].in), pgm_read_word(&curve[i].out)};
+        if (in < high.in) {
+            if (in <= low.in) {
+                return low.out;
+            }
+            return low.out + ((int32_t)high.out - low.out) * (int32_t)(in - low.in) / (high.in - low.in);
+        }
+        low = high;
+    }
+    return low.out;
+}
+
+static uint8_t smooth_scroll_direction(uint16_t keycode) {
+    switch (keycode) {
+        case KC_WH_U:
+            return SMOOTH_SCROLL_UP;
+        case KC_WH_D:
+            return SMOOTH_SCROLL_DOWN;
+        case KC_WH_L:
+            return SMOOTH_SCROLL_LEFT;
+        case KC_WH_R:
+            return SMOOTH_SCROLL_RIGHT;
+        default:
+            return 0;
+    }
+}
+
+static void smooth_scroll_reset(void) {
+    smooth_scroll_carry_v = 0;
+    smooth_scroll_carry_h = 0;
+}
+
+bool process_smooth_scroll(uint16_t keycode, keyrecord_t *record) {
+#if defined (DRGSCRL)
+    // Taken over from the keyboard so that sensor motion reaches us unscaled.
+    if (keycode == DRGSCRL) {
+        smooth_scroll_dragging = record->event.pressed;
+        smooth_scroll_reset();
+        return false;
+    }
+#endif
+    const uint8_t direction = smooth_scroll_direction(keycode);
+    if (direction == 0) {
+        return true;
+    }
+    if (record->event.pressed) {
+        if (smooth_scroll_directions == 0) {
+            smooth_scroll_start = timer_read32();
+            smooth_scroll_last  = smooth_scroll_start;
+            smooth_scroll_reset();
+        }
+        smooth_scroll_directions |= direction;
+    } else {
+        smooth_scroll_directions &= ~direction;
+    }
+    return false;
+}
+
+static mouse_hv_report_t smooth_scroll_emit(int32_t *carry) {
+    int32_t whole = *carry / 256;
+    *carry -= whole * 256;
+    return whole > HV_REPORT_MAX ? HV_REPORT_MAX : whole < HV_REPORT_MIN ? HV_REPORT_MIN : (mouse_hv_report_t)whole;
+}
+
+static void smooth_scroll_wheel(void) {
+    const uint32_t now     = timer_read32();
+    uint32_t       elapsed = TIMER_DIFF_32(now, smooth_scroll_last);
+    smooth_scroll_last     = now;
+    if (elapsed > SMOOTH_SCROLL_ELAPSED_MAX) {
+        elapsed = SMOOTH_SCROLL_ELAPSED_MAX;
+    }
+
+    const uint32_t rate = smooth_scroll_interpolate(smooth_scroll_wheel_curve, SMOOTH_SCROLL_CURVE_LENGTH(smooth_scroll_wheel_curve), TIMER_DIFF_32(now, smooth_scroll_start));
+    // detents/s * units/detent * ms / 1000, in Q8
+    const int32_t step = rate * elapsed * pointing_device_get_hires_scroll_resolution() * 32 / 125;
+
+    smooth_scroll_carry_v += (!!(smooth_scroll_directions & SMOOTH_SCROLL_UP) - !!(smooth_scroll_directions & SMOOTH_SCROLL_DOWN)) * step;
+    smooth_scroll_carry_h += (!!(smooth_scroll_directions & SMOOTH_SCROLL_RIGHT) - !!(smooth_scroll_directions & SMOOTH_SCROLL_LEFT)) * step;
+}
+
+static int32_t smooth_scroll_clamp_counts(int32_t counts) {
+    return counts > 1000 ? 1000 : counts < -1000 ? -1000 : counts;
+}
+
+static void smooth_scroll_drag(report_mouse_t *mouse_report) {
+    const int32_t x = smooth_scroll_clamp_counts(mouse_report->x);
+    const int32_t y = smooth_scroll_clamp_counts(mouse_report->y);
+    mouse_report->x = 0;
+    mouse_report->y = 0;
+    if (x == 0 && y == 0) {
+        return;
+    }
+
+    const uint16_t cpi = pointing_device_get_cpi();
+    if (cpi == 0) {
+        return;
+    }
+    const uint32_t ax    = x < 0 ? -x : x;
+    const uint32_t ay    = y < 0 ? -y : y;
+    const uint32_t speed = ax > ay ? ax + ay / 2 : ay + ax / 2;
+    const int32_t  gain  = smooth_scroll_interpolate(smooth_scroll_drag_curve, SMOOTH_SCROLL_CURVE_LENGTH(smooth_scroll_drag_curve), speed);
+    // counts * Q8 gain * detents/inch * units/detent / counts/inch
+    const int32_t scale = gain * MIRYOKU_SMOOTH_SCROLL_DRAG_DETENTS_PER_INCH * pointing_device_get_hires_scroll_resolution();
+
+#if defined (CHARYBDIS_DRAGSCROLL_REVERSE_X)
+    smooth_scroll_carry_h -= (int64_t)x * scale / cpi;
+#else
+    smooth_scroll_carry_h += (int64_t)x * scale / cpi;
+#endif
+#if defined (CHARYBDIS_DRAGSCROLL_REVERSE_Y)
+    smooth_scroll_carry_v -= (int64_t)y * scale / cpi;
+#else
+    smooth_scroll_carry_v += (int64_t)y * scale / cpi;
+#endif
+}
+
+report_mouse_t pointing_device_task_smooth_scroll(report_mouse_t mouse_report) {
+    if (smooth_scroll_directions == 0 && !smooth_scroll_dragging) {
+        return mouse_report;
+    }
+    if (smooth_scroll_directions != 0) {
+        smooth_scroll_wheel();
+    }
+    if (smooth_scroll_dragging) {
+        smooth_scroll_drag(&mouse_report);
+    }
+    mouse_report.v = smooth_scroll_emit(&smooth_scroll_carry_v);
+    mouse_report.h = smooth_scroll_emit(&smooth_scroll_carry_h);
+    return mouse_report;
+}
@@ -0,0 +1,34 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+#if !defined (POINTING_DEVICE_ENABLE) || !defined (POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+#    error "MIRYOKU_SMOOTH_SCROLL requires a pointing device with POINTING_DEVICE_HIRES_SCROLL_ENABLE"
+#endif
+
+// Wheel key speed as {ms held, detents per second} points, ascending in time,
+// interpolated and held after the last point.  The default follows the stock
+// mouse key wheel: 12.5/s rising to 100/s.
+#ifndef MIRYOKU_SMOOTH_SCROLL_WHEEL_CURVE
+#    define MIRYOKU_SMOOTH_SCROLL_WHEEL_CURVE {0, 12}, {1000, 40}, {3200, 100}
+#endif
+
+// Drag scroll distance, in detents per inch of sensor travel at gain 1.0.
+#ifndef MIRYOKU_SMOOTH_SCROLL_DRAG_DETENTS_PER_INCH
+#    define MIRYOKU_SMOOTH_SCROLL_DRAG_DETENTS_PER_INCH 16
+#endif
+
+// Drag scroll acceleration as {counts per report, Q8 gain} points, ascending
+// in speed, interpolated and held after the last point.  Independent of the
+// pointer acceleration curve.
+#ifndef MIRYOKU_SMOOTH_SCROLL_DRAG_CURVE
+#    define MIRYOKU_SMOOTH_SCROLL_DRAG_CURVE {0, 256}, {4, 256}, {16, 384}, {48, 640}
+#endif
+
+bool           process_smooth_scroll(uint16_t keycode, keyrecord_t *record);
+report_mouse_t pointing_device_task_smooth_scroll(report_mouse_t mouse_report);
@@ -0,0 +1,207 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "split_sync.h"
+
+#include "manna-harbour_miryoku.h"
+#include "transactions.h"
+#include "transport.h"
+
+// Layer and modifier state is sent to the secondary half as a delta over one
+// user RPC transaction: a header with sequence number and field mask, the
+// changed fields packed in mask order, and a checksum.  Fields stay pending
+// until the secondary acknowledges the sequence number, so a lost packet is
+// resent with anything that changed since.
+
+enum {
+    SPLIT_SYNC_LAYER         = 1 << 0,
+    SPLIT_SYNC_DEFAULT_LAYER = 1 << 1,
+    SPLIT_SYNC_MODS          = 1 << 2,
+    SPLIT_SYNC_ONESHOT_MODS  = 1 << 3,
+    SPLIT_SYNC_ALL           = (1 << 4) - 1,
+};
+
+enum {
+    SPLIT_SYNC_OK,
+    SPLIT_SYNC_BAD_CHECKSUM,
+};
+
+typedef struct {
+    layer_state_t layer;
+    layer_state_t default_layer;
+    uint8_t       mods;
+    uint8_t       oneshot_mods;
+} split_sync_state_t;
+
+typedef struct {
+    uint8_t sequence;
+    uint8_t status;
+} split_sync_ack_t;
+
+// sequence, mask, fields, checksum
+#define SPLIT_SYNC_PACKET_MAX (2 + sizeof(split_sync_state_t) + 1)
+
+static split_sync_stats_t split_sync_stats;
+static split_sync_state_t split_sync_sent;
+static uint8_t            split_sync_pending  = SPLIT_SYNC_ALL;
+static uint8_t            split_sync_sequence = 0;
+static uint32_t           split_sync_last     = 0;
+static uint32_t           split_sync_cleared  = 0;
+
+static uint8_t split_sync_checksum(const uint8_t *data, uint8_t length) {
+    uint8_t sum = 0xA5;
+    for (uint8_t i = 0; i < length; i++) {
+        sum = (uint8_t)((sum << 1) | (sum >> 7)) ^ data[i];
+    }
+    return sum;
+}
+
+static uint8_t split_sync_field_size(uint8_t field) {
+    switch (field) {
+        case SPLIT_SYNC_LAYER:
+        case SPLIT_SYNC_DEFAULT_LAYER:
+            return sizeof(layer_state_t);
+        default:
+            return sizeof(uint8_t);
+    }
+}
+
+static void *split_sync_field(split_sync_state_t *state, uint8_t field) {
+    switch (field) {
+        case SPLIT_SYNC_LAYER:
+            return &state->layer;
+        case SPLIT_SYNC_DEFAULT_LAYER:
+            return &state->default_layer;
+        case SPLIT_SYNC_MODS:
+            return &state->mods;
+        default:
+            return &state->oneshot_mods;
+    }
+}
+
+static void split_sync_receive(uint8_t in_length, const void *in_data, uint8_t out_length, void *out_data) {
+    const uint8_t    *packet = in_data;
+    split_sync_ack_t *ack    = out_data;
+    if (in_length < 3 || out_length < sizeof(split_sync_ack_t)) {
+        return;
+    }
+    ack->sequence = packet[0];
+    ack->status   = SPLIT_SYNC_BAD_CHECKSUM;
+
+    const uint8_t mask   = packet[1];
+    uint8_t       length = 2;
+    for (uint8_t field = 1; field & SPLIT_SYNC_ALL; field <<= 1) {
+        if (mask & field) {
+            length += split_sync_field_size(field);
+        }
+    }
+    if (length + 1 > in_length || split_sync_checksum(packet, length) != packet[length]) {
+        return;
+    }
+
+    split_sync_state_t state = {layer_state, default_layer_state, get_mods(), get_oneshot_mods()};
+    const uint8_t     *data  = packet + 2;
+    for (uint8_t field = 1; field & SPLIT_SYNC_ALL; field <<= 1) {
+        if (mask & field) {
+            memcpy(split_sync_field(&state, field), data, split_sync_field_size(field));
+            data += split_sync_field_size(field);
+        }
+    }
+    // Assigned directly, as for SPLIT_LAYER_STATE_ENABLE, so that layer
+    // callbacks only run on the primary half.
+    layer_state         = state.layer;
+    default_layer_state = state.default_layer;
+    set_mods(state.mods);
+    set_oneshot_mods(state.oneshot_mods);
+    ack->status = SPLIT_SYNC_OK;
+}
+
+void split_sync_init(void) {
+    transaction_register_rpc(U_SPLIT_SYNC, split_sync_receive);
+}
+
+void split_sync_task(void) {
+    if (!is_keyboard_master() || !is_transport_connected()) {
+        return;
+    }
+
+    split_sync_state_t state = {layer_state, default_layer_state, get_mods(), get_oneshot_mods()};
+    for (uint8_t field = 1; field & SPLIT_SYNC_ALL; field <<= 1) {
+        if (memcmp(split_sync_field(&state, field), split_sync_field(&split_sync_sent, field), split_sync_field_size(field)) != 0) {
+            split_sync_pending |= field;
+        }
+    }
+    if (split_sync_pending == 0) {
+        if (timer_elapsed32(split_sync_last) < MIRYOKU_SPLIT_SYNC_KEEPALIVE) {
+            return;
+        }
+        split_sync_pending = SPLIT_SYNC_ALL;
+        split_sync_stats.keepalives++;
+    }
+
+    uint8_t packet[SPLIT_SYNC_PACKET_MAX];
+    uint8_t length = 2;
+    packet[0]      = split_sync_sequence;
+    packet[1]      = split_sync_pending;
+    for (uint8_t field = 1; field & SPLIT_SYNC_ALL; field <<= 1) {
+        if (split_sync_pending & field) {
+            memcpy(&packet[length], split_sync_field(&state, field), split_sync_field_size(field));
+            length += split_sync_field_size(field);
+        }
+    }
+    packet[length] = split_sync_checksum(packet, length);
+    length++;
+
+    split_sync_ack_t ack = {(uint8_t)~split_sync_sequence, SPLIT_SYNC_BAD_CHECKSUM};
+    split_sync_stats.bytes += length;
+    split_sync_last = timer_read32();
+    if (!transaction_rpc_exec(U_SPLIT_SYNC, length, packet, sizeof(ack), &ack) || ack.sequence != split_sync_sequence) {
+        split_sync_stats.retransmits++;
+        return;
+    }
+    if (ack.status != SPLIT_SYNC_OK) {
+        split_sync_stats.checksum++;
+        split_sync_stats.retransmits++;
+        return;
+    }
+
+    split_sync_stats.packets++;
+    split_sync_sent    = state;
+    split_sync_pending = 0;
+    split_sync_sequence++;
+}
+
+const split_sync_stats_t *split_sync_get_stats(void) {
+    return &split_sync_stats;
+}
+
+void split_sync_clear_stats(void) {
+    memset(&split_sync_stats, 0, sizeof(split_sync_stats));
+    split_sync_cleared = timer_read32();
+}
+
+static void split_sync_put32(uint8_t *data, uint32_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+bool split_sync_raw_hid(uint8_t *data, uint8_t length) {
+    if (length < 26 || data[0] != U_RAW_HID_SPLIT_SYNC) {
+        return false;
+    }
+    if (data[1] == SPLIT_SYNC_CLEAR) {
+        split_sync_clear_stats();
+    }
+    memset(&data[2], 0, length - 2);
+    split_sync_put32(&data[2], split_sync_stats.packets);
+    split_sync_put32(&data[6], split_sync_stats.bytes);
+    split_sync_put32(&data[10], split_sync_stats.keepalives);
+    split_sync_put32(&data[14], split_sync_stats.retransmits);
+    split_sync_put32(&data[18], split_sync_stats.checksum);
+    split_sync_put32(&data[22], timer_elapsed32(split_sync_cleared));
+    return true;
+}
@@ -0,0 +1,37 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+// Full state is resent after this many ms without a change, so a secondary
+// that was reset or missed a packet catches up.
+#ifndef MIRYOKU_SPLIT_SYNC_KEEPALIVE
+#    define MIRYOKU_SPLIT_SYNC_KEEPALIVE 3000
+#endif
+
+typedef struct {
+    uint32_t packets;     // packets acknowledged by the secondary
+    uint32_t bytes;       // bytes sent, including failed attempts
+    uint32_t keepalives;  // full state resends without a change
+    uint32_t retransmits; // packets resent after a failed transaction or bad ack
+    uint32_t checksum;    // packets the secondary rejected on checksum
+} split_sync_stats_t;
+
+// Raw HID, U_RAW_HID_SPLIT_SYNC followed by one of these.  Replies echo the
+// two command bytes.  Values are little-endian.  The ms since the counts were
+// cleared give link utilization as bytes per ms.
+enum split_sync_commands {
+    SPLIT_SYNC_GET,   // -> packets, bytes, keepalives, retransmits, checksum, ms since clear (4 each)
+    SPLIT_SYNC_CLEAR, // -> as SPLIT_SYNC_GET, after clearing the counts
+};
+
+void split_sync_init(void);
+void split_sync_task(void);
+
+const split_sync_stats_t *split_sync_get_stats(void);
+void                      split_sync_clear_stats(void);
+bool                      split_sync_raw_hid(uint8_t *data, uint8_t length);
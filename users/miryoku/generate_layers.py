@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# Copyright 2026 pehweihang
+# https://github.com/pehweihang/qmk_userspace
+
+# This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+"""Resolve the Miryoku layer selection for one set of options.
+
+Evaluates miryoku_babel/miryoku_layer_selection.h for the given -D options
+and writes the selected layers, with the alternatives inlined, to
+<cache>/<key>/miryoku_layers_generated.h.  The key is a hash of the options
+and of the inputs, so keyboards built with the same options share one file.
+Prints the directory of the generated header.
+
+With --option-sets, prints instead each MIRYOKU_ALPHAS with and without each
+MIRYOKU_LAYERS known to the selection, one <ALPHAS>[_<LAYERS>] per line, for
+test-miryoku.
+
+usage: generate_layers.py CACHE_DIR [-DOPTION ...]
+       generate_layers.py --option-sets
+"""
+
+import hashlib
+import os
+import re
+import sys
+import tempfile
+
+BABEL = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'miryoku_babel')
+ALTERNATIVES = os.path.join(BABEL, 'miryoku_layer_alternatives.h')
+SELECTION = os.path.join(BABEL, 'miryoku_layer_selection.h')
+LIST = os.path.join(BABEL, 'miryoku_layer_list.h')
+HEADER = 'miryoku_layers_generated.h'
+
+# US shifted keycodes and their unshifted keys
+SHIFTED = {
+    'KC_TILD': 'KC_GRV', 'KC_EXLM': 'KC_1', 'KC_AT': 'KC_2', 'KC_HASH': 'KC_3', 'KC_DLR': 'KC_4',
+    'KC_PERC': 'KC_5', 'KC_CIRC': 'KC_6', 'KC_AMPR': 'KC_7', 'KC_ASTR': 'KC_8', 'KC_LPRN': 'KC_9',
+    'KC_RPRN': 'KC_0', 'KC_UNDS': 'KC_MINS', 'KC_PLUS': 'KC_EQL', 'KC_LCBR': 'KC_LBRC', 'KC_RCBR': 'KC_RBRC',
+    'KC_PIPE': 'KC_BSLS', 'KC_COLN': 'KC_SCLN', 'KC_DQUO': 'KC_QUOT', 'KC_LABK': 'KC_COMM', 'KC_RABK': 'KC_DOT',
+    'KC_QUES': 'KC_SLSH',
+}
+UNSHIFTED = {key: shifted for shifted, key in SHIFTED.items()}
+MODIFIERS = {'KC_LCTL', 'KC_LSFT', 'KC_LALT', 'KC_LGUI', 'KC_RCTL', 'KC_RSFT', 'KC_RALT', 'KC_RGUI', 'KC_ALGR'}
+
+DEFINED = re.compile(r'^(!?)\s*defined\s*\(?\s*(\w+)\s*\)?$')
+
+
+def logical_lines(path):
+    """Lines with backslash continuations joined, continuations kept as newlines."""
+    with open(path) as f:
+        text = f.read()
+    return text.replace('\\\n', '\x00').split('\n')
+
+
+def parse_define(line):
+    name, _, body = line.strip()[len('#define'):].strip().partition(' ')
+    return name, body.strip()
+
+
+def evaluate(condition, defines):
+    match = DEFINED.match(condition.strip())
+    if not match:
+        raise ValueError(f'unsupported condition: {condition}')
+    negate, name = match.groups()
+    return (name in defines) != bool(negate)
+
+
+def preprocess(path, defines):
+    """Evaluate the #if/#elif/#else/#endif and #define subset used by the babel headers."""
+    stack = []  # (active, taken) per open #if
+    for line in logical_lines(path):
+        directive = line.strip()
+        active = all(frame[0] for frame in stack)
+        if directive.startswith('#if '):
+            taken = active and evaluate(directive[len('#if '):], defines)
+            stack.append([taken, taken])
+        elif directive.startswith('#elif '):
+            frame = stack[-1]
+            parent = all(f[0] for f in stack[:-1])
+            frame[0] = parent and not frame[1] and evaluate(directive[len('#elif '):], defines)
+            frame[1] = frame[1] or frame[0]
+        elif directive.startswith('#else'):
+            frame = stack[-1]
+            parent = all(f[0] for f in stack[:-1])
+            frame[0] = parent and not frame[1]
+            frame[1] = True
+        elif directive.startswith('#endif'):
+            stack.pop()
+        elif directive.startswith('#define') and active:
+            name, body = parse_define(directive)
+            defines[name] = body
+
+
+def layers():
+    for line in logical_lines(LIST):
+        for name in re.findall(r'MIRYOKU_X\((\w+),', line):
+            yield name
+
+
+def inline(body, defines):
+    body = body.strip()
+    if re.fullmatch(r'MIRYOKU_ALTERNATIVES_\w+', body) and body in defines:
+        body = defines[body]
+    return body.replace('\x00', '\\\n')
+
+
+def keycodes(body):
+    return [token.strip() for token in re.split(r',(?![^()]*\))', body.replace('\x00', ' ')) if token.strip()]
+
+
+def shift_overrides(defines):
+    """Shift on Num gives the Sym key at the same position, where plain shift does not.
+
+    Keys whose own shifted symbol is on Sym, the digits included, keep it:
+    Shift + 0 stays ), whatever Sym has at the same position.
+    """
+    overrides = {}
+    num = keycodes(inline(defines['MIRYOKU_LAYER_NUM'], defines).replace('\\\n', ' '))
+    sym = keycodes(inline(defines['MIRYOKU_LAYER_SYM'], defines).replace('\\\n', ' '))
+    for trigger, replacement in zip(num, sym):
+        if not (re.fullmatch(r'KC_\w+', trigger) and re.fullmatch(r'KC_\w+', replacement)):
+            continue
+        if trigger in MODIFIERS or replacement in MODIFIERS or trigger == replacement:
+            continue
+        if SHIFTED.get(replacement) == trigger:
+            continue
+        if re.fullmatch(r'KC_\d', trigger) or UNSHIFTED.get(trigger) in sym:
+            continue
+        overrides.setdefault(trigger, replacement)
+    return overrides
+
+
+def generate(options):
+    defines = {name: '1' for name in options}
+    preprocess(ALTERNATIVES, defines)
+    preprocess(SELECTION, defines)
+
+    out = [
+        '// generated by generate_layers.py -*- buffer-read-only: t -*-',
+        '// options: ' + (' '.join('-D' + name for name in options) or 'none'),
+        '',
+        '#pragma once',
+        '',
+    ]
+    for layer in layers():
+        for macro in (f'MIRYOKU_LAYER_{layer}', f'MIRYOKU_LAYERMAPPING_{layer}'):
+            out += [
+                f'#if !defined ({macro})',
+                f'#define {macro} {inline(defines[macro], defines)}',
+                '#endif',
+            ]
+        out.append('')
+
+    out.append('#define MIRYOKU_SHIFT_OVERRIDE_LIST \\')
+    for trigger, replacement in shift_overrides(defines).items():
+        out.append(f'MIRYOKU_SHIFT_OVERRIDE({trigger[3:]}, {trigger}, {replacement}) \\')
+    out += ['', '']
+    return '\n'.join(out)
+
+
+def option_sets():
+    """Each alphas option, alone and with each layers option."""
+    with open(SELECTION) as f:
+        text = f.read()
+    alphas = sorted(set(re.findall(r'\bMIRYOKU_ALPHAS_(\w+)', text)))
+    layers = sorted(set(re.findall(r'\bMIRYOKU_LAYERS_(\w+)', text)))
+    return [f'{alpha}{suffix}' for alpha in alphas for suffix in [''] + [f'_{layer}' for layer in layers]]
+
+
+def main(argv):
+    if len(argv) == 2 and argv[1] == '--option-sets':
+        print('\n'.join(option_sets()))
+        return
+    if len(argv) < 2:
+        sys.exit(__doc__)
+    cache = argv[1]
+    options = sorted({arg[2:].split('=')[0] for arg in argv[2:] if arg.startswith('-DMIRYOKU_')})
+
+    key = hashlib.sha1()
+    key.update(' '.join(options).encode())
+    for path in (__file__, ALTERNATIVES, SELECTION, LIST):
+        with open(path, 'rb') as f:
+            key.update(f.read())
+    directory = os.path.join(cache, key.hexdigest()[:16])
+    header = os.path.join(directory, HEADER)
+
+    if not os.path.exists(header):
+        os.makedirs(directory, exist_ok=True)
+        # written aside and renamed, for parallel builds of the same options
+        fd, temporary = tempfile.mkstemp(dir=directory)
+        with os.fdopen(fd, 'w') as f:
+            f.write(generate(options))
+        os.replace(temporary, header)
+
+    print(directory)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -7,40 +7,347 @@
 
 #include "manna-harbour_miryoku.h"
 
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+  #include "features/bilateral_combinations.h"
+#endif
+#if defined (MIRYOKU_FLOW_TAP)
+  #include "features/flow_tap.h"
+#endif
+#if defined (MIRYOKU_KINETIC_MOUSEKEY)
+  #include "features/kinetic_mousekey.h"
+#endif
+#if defined (MIRYOKU_SMOOTH_SCROLL)
+  #include "features/smooth_scroll.h"
+#endif
+#if defined (MIRYOKU_SPLIT_SYNC)
+  #include "features/split_sync.h"
+#endif
+#if defined (MIRYOKU_DEBOUNCE_EAGER)
+  #include "features/debounce_eager.h"
+#endif
+#if defined (MIRYOKU_ALPHA_SELECT)
+  #include "features/alpha_select.h"
+#endif
+#if defined (MIRYOKU_CLIPBOARD_OS)
+  #include "features/os_clipboard.h"
+#endif
+#if defined (MIRYOKU_ADAPTIVE_TAPPING_TERM)
+  #include "features/adaptive_tapping_term.h"
+#endif
+#if defined (MIRYOKU_AUTO_SHIFT_ADAPT)
+  #include "features/auto_shift_adapt.h"
+#endif
+#if defined (MIRYOKU_KEY_OVERRIDE_FILTER)
+  #include "features/key_override_filter.h"
+#endif
+#if defined (MIRYOKU_SCHEDULER)
+  #include "features/scheduler.h"
+#endif
+#if defined (MIRYOKU_IDLE_SCAN)
+  #include "features/idle_scan.h"
+#endif
+#if defined (MIRYOKU_LAYER_CACHE)
+  #include "features/layer_cache.h"
+#endif
+#if defined (MIRYOKU_LATENCY_TRACE) || defined (MIRYOKU_PROFILER)
+  #include "features/cycles.h"
+#endif
+#if defined (MIRYOKU_LATENCY_TRACE)
+  #include "features/latency_trace.h"
+#endif
+#if defined (MIRYOKU_PROFILER)
+  #include "features/profiler.h"
+#endif
+#if defined (RAW_ENABLE)
+  #include "raw_hid.h"
+#endif
 
-#ifdef MACCEL_ENABLE
+
+#if defined (MIRYOKU_SMOOTH_SCROLL) || defined (MIRYOKU_MACCEL_FIXED) || defined (MACCEL_ENABLE) || defined (MIRYOKU_PROFILER)
 report_mouse_t pointing_device_task_user(report_mouse_t mouse_report) {
-    return pointing_device_task_maccel(mouse_report);
+#if defined (MIRYOKU_PROFILER)
+    const uint32_t profiler = profiler_start();
+#endif
+#if defined (MIRYOKU_SMOOTH_SCROLL)
+    mouse_report = pointing_device_task_smooth_scroll(mouse_report);
+#endif
+#if defined (MIRYOKU_MACCEL_FIXED)
+    mouse_report = pointing_device_task_maccel_fixed(mouse_report);
+#elif defined (MACCEL_ENABLE)
+    mouse_report = pointing_device_task_maccel(mouse_report);
+#endif
+#if defined (MIRYOKU_PROFILER)
+    profiler_stop(PROFILER_POINTING, profiler);
+#endif
+    return mouse_report;
+}
+#endif
+
+// bilateral combinations
+
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
+    return bilateral_combinations_key(keycode);
+}
+#endif
+
+
+// record and housekeeping hooks
+
+#if defined (MIRYOKU_KLUDGE_THUMBCOMBOS)
+static void u_thumbcombo_track(uint16_t keycode, keyrecord_t *record);
+#endif
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+#if defined (MIRYOKU_LATENCY_TRACE)
+    latency_trace_record(LATENCY_TRACE_MATRIX, record);
+#endif
+#if defined (MIRYOKU_IDLE_SCAN)
+    idle_scan_record(record);
+#endif
+#if defined (MIRYOKU_ADAPTIVE_TAPPING_TERM)
+    adaptive_tapping_term_record(record);
+#endif
+#if defined (MIRYOKU_FLOW_TAP)
+    if (!process_flow_tap(keycode, record)) {
+#if defined (MIRYOKU_LATENCY_TRACE)
+        latency_trace_record(LATENCY_TRACE_STOPPED, record);
+#endif
+        return false;
+    }
+#endif
+#if defined (MIRYOKU_KLUDGE_THUMBCOMBOS)
+    u_thumbcombo_track(keycode, record);
+#endif
+    return true;
+}
+
+static bool u_process_record(uint16_t keycode, keyrecord_t *record) {
+#if defined (MIRYOKU_AUTO_SHIFT_ADAPT)
+    if (!process_auto_shift_adapt(keycode, record)) {
+        return false;
+    }
+#endif
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+    if (!process_bilateral_combinations(keycode, record)) {
+        return false;
+    }
+#endif
+#if defined (MIRYOKU_KINETIC_MOUSEKEY)
+    if (!process_kinetic_mousekey(keycode, record)) {
+        return false;
+    }
+#endif
+#if defined (MIRYOKU_SMOOTH_SCROLL)
+    if (!process_smooth_scroll(keycode, record)) {
+        return false;
+    }
+#endif
+#if defined (MIRYOKU_ALPHA_SELECT)
+    if (!process_alpha_select(keycode, record)) {
+        return false;
+    }
+#endif
+#if defined (MIRYOKU_CLIPBOARD_OS)
+    if (!process_os_clipboard(keycode, record)) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+// A record stopped here skips post_process_record_user.
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+#if defined (MIRYOKU_LATENCY_TRACE)
+    latency_trace_record(LATENCY_TRACE_RESOLVED, record);
+    if (!u_process_record(keycode, record)) {
+        latency_trace_record(LATENCY_TRACE_STOPPED, record);
+        return false;
+    }
+    return true;
+#else
+    return u_process_record(keycode, record);
+#endif
+}
+
+#if defined (MIRYOKU_LATENCY_TRACE)
+void post_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    latency_trace_record(LATENCY_TRACE_REPORT, record);
+}
+#endif
+
+// layer state hooks
+
+#if defined (MIRYOKU_LAYER_CACHE)
+layer_state_t layer_state_set_user(layer_state_t state) {
+    if (state != layer_state) {
+        layer_cache_clear();
+    }
+    return state;
+}
+
+layer_state_t default_layer_state_set_user(layer_state_t state) {
+    if (state != default_layer_state) {
+        layer_cache_clear();
+    }
+    return state;
 }
 #endif
 
+// user EEPROM settings
+
+miryoku_config_t miryoku_config;
+
+void eeconfig_init_user(void) {
+    miryoku_config.raw = 0;
+    eeconfig_update_user(miryoku_config.raw);
+}
+
+void keyboard_post_init_user(void) {
+    miryoku_config.raw = eeconfig_read_user();
+#if defined (BILATERAL_COMBINATIONS_THUMBS)
+    bilateral_combinations_init();
+#endif
+#if defined (MIRYOKU_SPLIT_SYNC)
+    split_sync_init();
+#endif
+#if defined (MIRYOKU_AUTO_SHIFT_ADAPT)
+    auto_shift_adapt_init();
+#endif
+#if defined (MIRYOKU_KEY_OVERRIDE_FILTER)
+    key_override_filter_init();
+#endif
+#if defined (MIRYOKU_LATENCY_TRACE) || defined (MIRYOKU_PROFILER)
+    cycles_init();
+#endif
+}
+
+void housekeeping_task_user(void) {
+#if defined (MIRYOKU_PROFILER)
+    const uint32_t profiler = profiler_start();
+#endif
+#if defined (MIRYOKU_SCHEDULER)
+    scheduler_task();
+#else
+#if defined (BILATERAL_COMBINATIONS) || defined (BILATERAL_COMBINATIONS_THUMBS)
+    bilateral_combinations_task();
+#endif
+#if defined (MIRYOKU_KINETIC_MOUSEKEY)
+    kinetic_mousekey_task();
+#endif
+#if defined (MIRYOKU_AUTO_SHIFT_ADAPT)
+    auto_shift_adapt_task();
+#endif
+#endif
+#if defined (MIRYOKU_SPLIT_SYNC)
+    split_sync_task();
+#endif
+#if defined (MIRYOKU_LATENCY_TRACE) || defined (MIRYOKU_PROFILER)
+    cycles_task();
+#endif
+#if defined (MIRYOKU_PROFILER)
+    profiler_stop(PROFILER_HOUSEKEEPING, profiler);
+    profiler_task();
+#endif
+#if defined (MIRYOKU_IDLE_SCAN)
+    idle_scan_task();
+#endif
+}
+
+#if defined (RAW_ENABLE)
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+#if defined (MIRYOKU_ALPHA_SELECT)
+    if (alpha_select_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_LATENCY_TRACE)
+    if (latency_trace_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_PROFILER)
+    if (profiler_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_FLOW_TAP)
+    if (flow_tap_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_ADAPTIVE_TAPPING_TERM)
+    if (adaptive_tapping_term_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_IDLE_SCAN)
+    if (idle_scan_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_MACCEL_FIXED)
+    if (maccel_fixed_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_SPLIT_SYNC)
+    if (split_sync_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#if defined (MIRYOKU_DEBOUNCE_EAGER)
+    if (debounce_eager_raw_hid(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+}
+#endif
+
+
 // Additional Features double tap guard
 
-enum {
-    U_TD_BOOT,
-#define MIRYOKU_X(LAYER, STRING) U_TD_U_##LAYER,
+// Guard targets: a layer to set as default, or boot.  One shared handler acts
+// on the second press itself and marks the dance finished, so QMK closes it
+// instead of waiting out the tapping term, and resets it on the release.  A
+// third tap starts a new dance.
+#define U_TD_GUARD_BOOT 0xFF
+
+static const uint8_t PROGMEM u_td_guards[] = {
+    [U_TD_BOOT] = U_TD_GUARD_BOOT,
+#define MIRYOKU_X(LAYER, STRING) [U_TD_U_##LAYER] = U_##LAYER,
 MIRYOKU_LAYER_LIST
 #undef MIRYOKU_X
 };
 
-void u_td_fn_boot(tap_dance_state_t *state, void *user_data) {
-  if (state->count == 2) {
+void u_td_fn_guard(tap_dance_state_t *state, void *user_data) {
+  if (state->count != 2) {
+    return;
+  }
+  uint8_t guard = pgm_read_byte((const uint8_t *)user_data);
+  // reset_tap_dance does nothing while the key is down
+  state->finished = true;
+  if (guard == U_TD_GUARD_BOOT) {
     reset_keyboard();
+  } else {
+    default_layer_set((layer_state_t)1 << guard);
   }
 }
 
-#define MIRYOKU_X(LAYER, STRING) \
-void u_td_fn_U_##LAYER(tap_dance_state_t *state, void *user_data) { \
-  if (state->count == 2) { \
-    default_layer_set((layer_state_t)1 << U_##LAYER); \
-  } \
-}
-MIRYOKU_LAYER_LIST
-#undef MIRYOKU_X
+#define U_ACTION_TAP_DANCE_GUARD(INDEX) {.fn = {.on_each_tap = u_td_fn_guard}, .user_data = (void *)&u_td_guards[INDEX]}
 
 tap_dance_action_t tap_dance_actions[] = {
-    [U_TD_BOOT] = ACTION_TAP_DANCE_FN(u_td_fn_boot),
-#define MIRYOKU_X(LAYER, STRING) [U_TD_U_##LAYER] = ACTION_TAP_DANCE_FN(u_td_fn_U_##LAYER),
+    [U_TD_BOOT] = U_ACTION_TAP_DANCE_GUARD(U_TD_BOOT),
+#define MIRYOKU_X(LAYER, STRING) [U_TD_U_##LAYER] = U_ACTION_TAP_DANCE_GUARD(U_TD_U_##LAYER),
 MIRYOKU_LAYER_LIST
 #undef MIRYOKU_X
 };
@@ -59,38 +366,94 @@ MIRYOKU_LAYER_LIST
 
 const key_override_t capsword_key_override = ko_make_basic(MOD_MASK_SHIFT, CW_TOGG, KC_CAPS);
 
+// Shift on Num gives the Sym key at the same position, for the positions
+// where plain Shift does not, as listed by generate_layers.py.
+#if defined (MIRYOKU_SHIFT_OVERRIDES) && defined (MIRYOKU_SHIFT_OVERRIDE_LIST)
+#define MIRYOKU_SHIFT_OVERRIDE(NAME, TRIGGER, REPLACEMENT) \
+const key_override_t u_shift_override_##NAME = ko_make_with_layers(MOD_MASK_SHIFT, TRIGGER, REPLACEMENT, (layer_state_t)1 << U_NUM);
+MIRYOKU_SHIFT_OVERRIDE_LIST
+#undef MIRYOKU_SHIFT_OVERRIDE
+#endif
+
 const key_override_t *key_overrides[] = {
-    &capsword_key_override
+    &capsword_key_override,
+#if defined (MIRYOKU_SHIFT_OVERRIDES) && defined (MIRYOKU_SHIFT_OVERRIDE_LIST)
+#define MIRYOKU_SHIFT_OVERRIDE(NAME, TRIGGER, REPLACEMENT) &u_shift_override_##NAME,
+MIRYOKU_SHIFT_OVERRIDE_LIST
+#undef MIRYOKU_SHIFT_OVERRIDE
+#endif
 };
 
 
 // thumb combos
 
 #if defined (MIRYOKU_KLUDGE_THUMBCOMBOS)
-const uint16_t PROGMEM thumbcombos_base_right[] = {LT(U_SYM, KC_ENT), LT(U_NUM, KC_BSPC), COMBO_END};
-const uint16_t PROGMEM thumbcombos_base_left[] = {LT(U_NAV, KC_SPC), LT(U_MOUSE, KC_TAB), COMBO_END};
-const uint16_t PROGMEM thumbcombos_nav[] = {KC_ENT, KC_BSPC, COMBO_END};
-const uint16_t PROGMEM thumbcombos_mouse[] = {KC_BTN2, KC_BTN1, COMBO_END};
-const uint16_t PROGMEM thumbcombos_media[] = {KC_MSTP, KC_MPLY, COMBO_END};
-const uint16_t PROGMEM thumbcombos_num[] = {KC_0, KC_MINS, COMBO_END};
   #if defined (MIRYOKU_LAYERS_FLIP)
-const uint16_t PROGMEM thumbcombos_sym[] = {KC_UNDS, KC_LPRN, COMBO_END};
+    #define MIRYOKU_THUMBCOMBO_SYM MIRYOKU_THUMBCOMBO(sym, KC_UNDS, KC_LPRN, KC_RPRN)
   #else
-const uint16_t PROGMEM thumbcombos_sym[] = {KC_RPRN, KC_UNDS, COMBO_END};
+    #define MIRYOKU_THUMBCOMBO_SYM MIRYOKU_THUMBCOMBO(sym, KC_RPRN, KC_UNDS, KC_LPRN)
   #endif
-const uint16_t PROGMEM thumbcombos_fun[] = {KC_SPC, KC_TAB, COMBO_END};
+
+#define MIRYOKU_THUMBCOMBO_LIST \
+MIRYOKU_THUMBCOMBO(base_right, LT(U_SYM, KC_ENT),  LT(U_NUM, KC_BSPC), LT(U_FUN, KC_DEL)) \
+MIRYOKU_THUMBCOMBO(base_left,  LT(U_NAV, KC_SPC),  LT(U_MOUSE, KC_TAB), LT(U_MEDIA, KC_ESC)) \
+MIRYOKU_THUMBCOMBO(nav,        KC_ENT,             KC_BSPC,            KC_DEL) \
+MIRYOKU_THUMBCOMBO(mouse,      KC_BTN2,            KC_BTN1,            KC_BTN3) \
+MIRYOKU_THUMBCOMBO(media,      KC_MSTP,            KC_MPLY,            KC_MUTE) \
+MIRYOKU_THUMBCOMBO(num,        KC_0,               KC_MINS,            KC_DOT) \
+MIRYOKU_THUMBCOMBO_SYM \
+MIRYOKU_THUMBCOMBO(fun,        KC_SPC,             KC_TAB,             KC_APP)
+
+enum miryoku_thumbcombos {
+#define MIRYOKU_THUMBCOMBO(NAME, KEY1, KEY2, RESULT) U_THUMBCOMBO_##NAME,
+MIRYOKU_THUMBCOMBO_LIST
+#undef MIRYOKU_THUMBCOMBO
+  U_THUMBCOMBO_NONE
+};
+
+#define MIRYOKU_THUMBCOMBO(NAME, KEY1, KEY2, RESULT) const uint16_t PROGMEM thumbcombos_##NAME[] = {KEY1, KEY2, COMBO_END};
+MIRYOKU_THUMBCOMBO_LIST
+#undef MIRYOKU_THUMBCOMBO
+
 combo_t key_combos[] = {
-  COMBO(thumbcombos_base_right, LT(U_FUN, KC_DEL)),
-  COMBO(thumbcombos_base_left, LT(U_MEDIA, KC_ESC)),
-  COMBO(thumbcombos_nav, KC_DEL),
-  COMBO(thumbcombos_mouse, KC_BTN3),
-  COMBO(thumbcombos_media, KC_MUTE),
-  COMBO(thumbcombos_num, KC_DOT),
-  #if defined (MIRYOKU_LAYERS_FLIP)
-  COMBO(thumbcombos_sym, KC_RPRN),
-  #else
-  COMBO(thumbcombos_sym, KC_LPRN),
-  #endif
-  COMBO(thumbcombos_fun, KC_APP)
+#define MIRYOKU_THUMBCOMBO(NAME, KEY1, KEY2, RESULT) [U_THUMBCOMBO_##NAME] = COMBO(thumbcombos_##NAME, RESULT),
+MIRYOKU_THUMBCOMBO_LIST
+#undef MIRYOKU_THUMBCOMBO
 };
+
+// Index from keycode to the one thumb combo it can take part in.  A keycode
+// in two combos is a duplicate case label, so the index stays unambiguous.
+static uint8_t u_thumbcombo_index(uint16_t keycode) {
+  switch (keycode) {
+#define MIRYOKU_THUMBCOMBO(NAME, KEY1, KEY2, RESULT) case KEY1: case KEY2: return U_THUMBCOMBO_##NAME;
+MIRYOKU_THUMBCOMBO_LIST
+#undef MIRYOKU_THUMBCOMBO
+    default:
+      return U_THUMBCOMBO_NONE;
+  }
+}
+
+// Early commit.  The combo engine fires as soon as both keys are down and
+// flushes on any non-combo key or release, but keeps waiting out COMBO_TERM
+// when the next press is a key of a different combo.  No combo can take both,
+// so flush the held key straight away instead.
+static uint8_t  u_thumbcombo_pending = U_THUMBCOMBO_NONE;
+static uint16_t u_thumbcombo_pending_time;
+
+static void u_thumbcombo_track(uint16_t keycode, keyrecord_t *record) {
+  if (!IS_KEYEVENT(record->event) || !is_combo_enabled()) {
+    return;
+  }
+  uint8_t index = record->event.pressed ? u_thumbcombo_index(keycode) : U_THUMBCOMBO_NONE;
+  if (index == U_THUMBCOMBO_NONE) {
+    u_thumbcombo_pending = U_THUMBCOMBO_NONE;
+    return;
+  }
+  if (u_thumbcombo_pending != U_THUMBCOMBO_NONE && u_thumbcombo_pending != index && timer_elapsed(u_thumbcombo_pending_time) < COMBO_TERM) {
+    combo_disable();
+    combo_enable();
+  }
+  u_thumbcombo_pending      = u_thumbcombo_pending == index ? U_THUMBCOMBO_NONE : index;
+  u_thumbcombo_pending_time = record->event.time;
+}
 #endif
@@ -5,10 +5,16 @@
 
 #pragma once
 
-#include "miryoku_babel/miryoku_layer_selection.h"
+#if defined (MIRYOKU_GENERATED_LAYERS)
+  #include "miryoku_layers_generated.h"
+#else
+  #include "miryoku_babel/miryoku_layer_selection.h"
+#endif
 #include "miryoku_babel/miryoku_layer_list.h"
 
-#ifdef MACCEL_ENABLE
+#if defined (MIRYOKU_MACCEL_FIXED)
+    #include "features/maccel_fixed.h"
+#elif defined (MACCEL_ENABLE)
     #include "features/maccel/maccel.h"
 #endif
 
@@ -18,6 +24,53 @@ MIRYOKU_LAYER_LIST
 #undef MIRYOKU_X
 };
 
+// Additional Features double tap guard
+enum {
+    U_TD_BOOT,
+#define MIRYOKU_X(LAYER, STRING) U_TD_U_##LAYER,
+MIRYOKU_LAYER_LIST
+#undef MIRYOKU_X
+};
+
+// raw HID commands, selected by the first byte of the report
+enum miryoku_raw_hid_commands {
+    U_RAW_HID_ALPHA_SELECT  = 0x41,
+    U_RAW_HID_MACCEL        = 0x43,
+    U_RAW_HID_DEBOUNCE      = 0x44,
+    U_RAW_HID_FLOW_TAP      = 0x46,
+    U_RAW_HID_IDLE_SCAN     = 0x49,
+    U_RAW_HID_LATENCY_TRACE = 0x4D,
+    U_RAW_HID_PROFILER      = 0x50,
+    U_RAW_HID_SPLIT_SYNC    = 0x53,
+    U_RAW_HID_TAPPING_TERM  = 0x54,
+};
+
+// custom keycodes
+enum miryoku_keycodes {
+    U_ALPHAS_NEXT = QK_USER,
+    U_EXTRA_NEXT,
+    U_TAP_NEXT,
+    U_CLIP_RDO,
+    U_CLIP_PST,
+    U_CLIP_CPY,
+    U_CLIP_CUT,
+    U_CLIP_UND,
+    U_CLIPBOARD_NEXT,
+};
+
+// settings kept in the user EEPROM word, all zero after an EEPROM reset
+typedef union {
+    uint32_t raw;
+    struct {
+        uint8_t alphas    : 4; // alpha_select, 0 for the compiled alphas
+        uint8_t extra     : 4;
+        uint8_t tap       : 4;
+        uint8_t clipboard : 3; // os_clipboard, 0 to follow the host OS
+    };
+} miryoku_config_t;
+
+extern miryoku_config_t miryoku_config;
+
 #define U_MACRO_VA_ARGS(macro, ...) macro(__VA_ARGS__)
 
 #if !defined (MIRYOKU_MAPPING)
@@ -46,6 +99,12 @@ MIRYOKU_LAYER_LIST
   #define U_CPY C(KC_C)
   #define U_CUT C(KC_X)
   #define U_UND C(KC_Z)
+#elif defined (MIRYOKU_CLIPBOARD_OS)
+  #define U_RDO U_CLIP_RDO
+  #define U_PST U_CLIP_PST
+  #define U_CPY U_CLIP_CPY
+  #define U_CUT U_CLIP_CUT
+  #define U_UND U_CLIP_UND
 #else
   #define U_RDO KC_AGIN
   #define U_PST S(KC_INS)
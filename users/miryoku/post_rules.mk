@@ -23,6 +23,11 @@ ifneq ($(strip $(MIRYOKU_CLIPBOARD)),)
   OPT_DEFS += -DMIRYOKU_CLIPBOARD_$(MIRYOKU_CLIPBOARD)
 endif
 
+ifeq ($(strip $(MIRYOKU_CLIPBOARD)),OS)
+  OS_DETECTION_ENABLE = yes
+  SRC += $(USER_PATH)/features/os_clipboard.c
+endif
+
 ifneq ($(strip $(MIRYOKU_LAYERS)),)
   OPT_DEFS += -DMIRYOKU_LAYERS_$(MIRYOKU_LAYERS)
 endif
@@ -33,6 +38,148 @@ ifneq ($(strip $(MIRYOKU_MAPPING)),)
   OPT_DEFS += -DMIRYOKU_MAPPING_$(MIRYOKU_MAPPING)
 endif
 
+# generated layers, the selection above resolved once per set of options
+ifeq ($(strip $(MIRYOKU_GENERATED_LAYERS)),yes)
+  MIRYOKU_GENERATED_LAYERS_CACHE ?= $(if $(BUILD_DIR),$(BUILD_DIR),.build)/miryoku
+  MIRYOKU_GENERATED_LAYERS_DIR := $(shell python3 $(USER_PATH)/generate_layers.py $(MIRYOKU_GENERATED_LAYERS_CACHE) $(filter -DMIRYOKU_%,$(OPT_DEFS)))
+  ifneq ($(MIRYOKU_GENERATED_LAYERS_DIR),)
+    OPT_DEFS += -DMIRYOKU_GENERATED_LAYERS
+    EXTRAINCDIRS += $(MIRYOKU_GENERATED_LAYERS_DIR)
+  endif
+endif
+
+# shift overrides, generated with the layers
+ifeq ($(strip $(MIRYOKU_SHIFT_OVERRIDES)),yes)
+  OPT_DEFS += -DMIRYOKU_SHIFT_OVERRIDES
+endif
+
+# flow tap
+ifeq ($(strip $(MIRYOKU_FLOW_TAP)),yes)
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_FLOW_TAP
+  SRC += $(USER_PATH)/features/flow_tap.c
+endif
+
+# compact keymap
+ifeq ($(strip $(MIRYOKU_COMPACT_KEYMAP)),yes)
+  OPT_DEFS += -DMIRYOKU_COMPACT_KEYMAP
+  SRC += $(USER_PATH)/features/compact_keymap.c
+endif
+
+# runtime alpha selection
+ifeq ($(strip $(MIRYOKU_ALPHA_SELECT)),yes)
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_ALPHA_SELECT
+  SRC += $(USER_PATH)/features/alpha_select.c
+endif
+
+# adaptive tapping term
+ifeq ($(strip $(MIRYOKU_ADAPTIVE_TAPPING_TERM)),yes)
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_ADAPTIVE_TAPPING_TERM
+  SRC += $(USER_PATH)/features/adaptive_tapping_term.c
+endif
+
+# adaptive auto shift
+ifeq ($(strip $(MIRYOKU_AUTO_SHIFT_ADAPT)),yes)
+  ifeq ($(strip $(AUTO_SHIFT_ENABLE)),yes)
+    OPT_DEFS += -DMIRYOKU_AUTO_SHIFT_ADAPT
+    SRC += $(USER_PATH)/features/auto_shift_adapt.c
+  endif
+endif
+
+# deferred scheduler for feature timers
+ifeq ($(strip $(MIRYOKU_SCHEDULER)),yes)
+  OPT_DEFS += -DMIRYOKU_SCHEDULER
+  SRC += $(USER_PATH)/features/scheduler.c
+endif
+
+# fixed-point mouse acceleration
+ifeq ($(strip $(MIRYOKU_MACCEL_FIXED)),yes)
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_MACCEL_FIXED
+  SRC += $(USER_PATH)/features/maccel_fixed.c
+endif
+
+# kinetic mouse keys
+ifeq ($(strip $(MIRYOKU_KINETIC_MOUSEKEY)),yes)
+  OPT_DEFS += -DMIRYOKU_KINETIC_MOUSEKEY
+  SRC += $(USER_PATH)/features/kinetic_mousekey.c
+endif
+
+# smooth scroll
+ifeq ($(strip $(MIRYOKU_SMOOTH_SCROLL)),yes)
+  OPT_DEFS += -DMIRYOKU_SMOOTH_SCROLL
+  SRC += $(USER_PATH)/features/smooth_scroll.c
+endif
+
+# split sync
+ifeq ($(strip $(MIRYOKU_SPLIT_SYNC)),yes)
+  ifeq ($(strip $(SPLIT_KEYBOARD)),yes)
+    RAW_ENABLE = yes
+    OPT_DEFS += -DMIRYOKU_SPLIT_SYNC
+    SRC += $(USER_PATH)/features/split_sync.c
+  endif
+endif
+
+# eager debounce
+ifeq ($(strip $(MIRYOKU_DEBOUNCE_EAGER)),yes)
+  DEBOUNCE_TYPE = custom
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_DEBOUNCE_EAGER
+  SRC += $(USER_PATH)/features/debounce_eager.c
+endif
+
+# latency trace
+ifeq ($(strip $(MIRYOKU_LATENCY_TRACE)),yes)
+  RAW_ENABLE = yes
+  OPT_DEFS += -DMIRYOKU_LATENCY_TRACE
+  SRC += $(USER_PATH)/features/latency_trace.c
+endif
+
+# profiler, timing QMK functions through linker wraps, which LTO bypasses
+ifeq ($(strip $(MIRYOKU_PROFILER)),yes)
+  RAW_ENABLE = yes
+  LTO_ENABLE = no
+  OPT_DEFS += -DMIRYOKU_PROFILER
+  SRC += $(USER_PATH)/features/profiler.c
+  EXTRALDFLAGS += -Wl,--wrap=matrix_scan
+  ifeq ($(strip $(SPLIT_KEYBOARD)),yes)
+    EXTRALDFLAGS += -Wl,--wrap=transport_master
+  endif
+  ifeq ($(strip $(TAP_DANCE_ENABLE)),yes)
+    EXTRALDFLAGS += -Wl,--wrap=process_tap_dance -Wl,--wrap=tap_dance_task
+  endif
+  ifeq ($(strip $(KEY_OVERRIDE_ENABLE)),yes)
+    ifneq ($(strip $(MIRYOKU_KEY_OVERRIDE_FILTER)),yes)
+      EXTRALDFLAGS += -Wl,--wrap=process_key_override
+    endif
+  endif
+endif
+
+# key override filter, skipping the engine through a linker wrap, which LTO bypasses
+ifeq ($(strip $(MIRYOKU_KEY_OVERRIDE_FILTER)),yes)
+  ifeq ($(strip $(KEY_OVERRIDE_ENABLE)),yes)
+    LTO_ENABLE = no
+    OPT_DEFS += -DMIRYOKU_KEY_OVERRIDE_FILTER
+    SRC += $(USER_PATH)/features/key_override_filter.c
+    EXTRALDFLAGS += -Wl,--wrap=process_key_override
+  endif
+endif
+
+# layer cache, replacing the layer walk through a linker wrap, which LTO bypasses
+ifeq ($(strip $(MIRYOKU_LAYER_CACHE)),yes)
+  LTO_ENABLE = no
+  OPT_DEFS += -DMIRYOKU_LAYER_CACHE
+  SRC += $(USER_PATH)/features/layer_cache.c
+  EXTRALDFLAGS += -Wl,--wrap=layer_switch_get_layer -Wl,--wrap=layer_switch_get_action -Wl,--wrap=store_or_get_action
+endif
+
+# cycle counter, shared by latency trace and profiler
+ifneq ($(filter yes,$(strip $(MIRYOKU_LATENCY_TRACE)) $(strip $(MIRYOKU_PROFILER))),)
+  SRC += $(USER_PATH)/features/cycles.c
+endif
+
 # kludges
 
 # thumb combos
@@ -40,3 +187,10 @@ ifeq ($(strip $(MIRYOKU_KLUDGE_THUMBCOMBOS)),yes)
   COMBO_ENABLE = yes
   OPT_DEFS += -DMIRYOKU_KLUDGE_THUMBCOMBOS
 endif
+
+# profiler, combos are enabled by the thumb combos kludge
+ifeq ($(strip $(MIRYOKU_PROFILER)),yes)
+  ifeq ($(strip $(COMBO_ENABLE)),yes)
+    EXTRALDFLAGS += -Wl,--wrap=process_combo -Wl,--wrap=combo_task
+  endif
+endif
@@ -10,6 +10,9 @@ KEY_OVERRIDE_ENABLE = yes
 
 INTROSPECTION_KEYMAP_C = manna-harbour_miryoku.c # keymaps
 
+SRC += $(USER_PATH)/features/bilateral_combinations.c
+SRC += $(USER_PATH)/features/idle_scan.c
+
 include $(USER_PATH)/custom_rules.mk
 
 include $(USER_PATH)/post_rules.mk
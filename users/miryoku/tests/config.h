@@ -0,0 +1,32 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "test_common.h"
+
+#if !defined (QMK_KEYBOARD_H)
+  #define QMK_KEYBOARD_H "quantum.h"
+#endif
+
+#define BILATERAL_COMBINATIONS_THUMBS
+
+// The 4x10 test matrix takes the Miryoku layout as is.
+#define XXX KC_NO
+
+#define LAYOUT_miryoku( \
+     K00, K01, K02, K03, K04,                          K05, K06, K07, K08, K09, \
+     K10, K11, K12, K13, K14,                          K15, K16, K17, K18, K19, \
+     K20, K21, K22, K23, K24,                          K25, K26, K27, K28, K29, \
+     N30, N31, K32, K33, K34,                          K35, K36, K37, N38, N39 \
+) \
+{ \
+{ K00, K01, K02, K03, K04, K05, K06, K07, K08, K09 }, \
+{ K10, K11, K12, K13, K14, K15, K16, K17, K18, K19 }, \
+{ K20, K21, K22, K23, K24, K25, K26, K27, K28, K29 }, \
+{ XXX, XXX, K32, K33, K34, K35, K36, K37, XXX, XXX } \
+}
+
+#include "miryoku/config.h"
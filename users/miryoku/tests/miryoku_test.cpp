@@ -0,0 +1,279 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "miryoku_test.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+extern const uint16_t u_test_keymaps[][MATRIX_ROWS][MATRIX_COLS];
+extern const uint8_t  u_test_keymap_layers;
+void                  u_keyboard_post_init_user(void);
+}
+
+static_assert(MATRIX_ROWS == TRACE_ROWS && MATRIX_COLS == TRACE_COLS, "traces are on the 4x10 test matrix");
+
+// longer than any test trace
+#define U_TEST_SETTLE 5000
+
+// the base layer, U_BASE
+#define U_TEST_BASE 0
+
+Miryoku::Miryoku() {
+    for (uint8_t layer = 0; layer < u_test_keymap_layers; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(layer, col, row, u_test_keymaps[layer][row][col]));
+            }
+        }
+    }
+    u_keyboard_post_init_user();
+    settle();
+}
+
+void Miryoku::settle(void) {
+    idle_for(U_TEST_SETTLE);
+    m_start = timer_read32();
+}
+
+uint32_t Miryoku::now(void) const {
+    return timer_read32() - m_start;
+}
+
+void Miryoku::scan(void) {
+    run_one_scan_loop();
+    if (m_on_scan) {
+        m_on_scan();
+    }
+}
+
+void Miryoku::advance_to(uint32_t time) {
+    while (now() < time) {
+        scan();
+    }
+}
+
+void Miryoku::replay(const std::vector<TraceEvent> &trace) {
+    for (const TraceEvent &event : trace) {
+        advance_to(event.time);
+        KeymapKey key(0, event.pos.col, event.pos.row, KC_NO);
+        if (event.pressed) {
+            key.press();
+        } else {
+            key.release();
+        }
+        scan();
+    }
+}
+
+uint16_t Miryoku::keycode_at(uint8_t layer, TracePos pos) const {
+    return u_test_keymaps[layer][pos.row][pos.col];
+}
+
+TracePos Miryoku::find_key(uint8_t layer, uint16_t keycode) const {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (u_test_keymaps[layer][row][col] == keycode) {
+                return {row, col};
+            }
+        }
+    }
+    ADD_FAILURE() << "keycode 0x" << std::hex << keycode << " not on layer " << std::dec << +layer;
+    return {0, 0};
+}
+
+TracePos Miryoku::find_alpha(TraceHand hand) const {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            const uint16_t keycode = u_test_keymaps[U_TEST_BASE][row][col];
+            if (hand_of({row, col}) == hand && keycode >= KC_A && keycode <= KC_Z) {
+                return {row, col};
+            }
+        }
+    }
+    ADD_FAILURE() << "no plain alpha for the hand";
+    return {0, 0};
+}
+
+TracePos Miryoku::find_mod_tap(TraceHand hand, uint8_t mods) const {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (hand_of({row, col}) == hand && hold_mods(u_test_keymaps[U_TEST_BASE][row][col]) == mods) {
+                return {row, col};
+            }
+        }
+    }
+    ADD_FAILURE() << "no mod-tap for mods 0x" << std::hex << +mods;
+    return {0, 0};
+}
+
+TracePos Miryoku::find_thumb(uint8_t layer) const {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        const uint16_t keycode = u_test_keymaps[U_TEST_BASE][MATRIX_ROWS - 1][col];
+        if (IS_QK_LAYER_TAP(keycode) && QK_LAYER_TAP_GET_LAYER(keycode) == layer) {
+            return {MATRIX_ROWS - 1, col};
+        }
+    }
+    ADD_FAILURE() << "no thumb key for layer " << +layer;
+    return {0, 0};
+}
+
+TraceHand Miryoku::hand_of(TracePos pos) {
+    return pos.col < MATRIX_COLS / 2 ? HAND_LEFT : HAND_RIGHT;
+}
+
+uint16_t Miryoku::tap_keycode(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        return QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    return keycode;
+}
+
+uint8_t Miryoku::hold_mods(uint16_t keycode) {
+    if (!IS_QK_MOD_TAP(keycode)) {
+        return 0;
+    }
+    // 5-bit mods, the top bit for the right hand
+    const uint8_t mods = QK_MOD_TAP_GET_MODS(keycode);
+    return mods & 0x10 ? (mods & 0x0F) << 4 : mods;
+}
+
+namespace {
+
+struct Report {
+    uint32_t          time; // ms, the end of the scan that sent it
+    report_keyboard_t report;
+};
+
+struct LayerSample {
+    uint32_t      time; // ms, the end of the scan
+    layer_state_t state;
+};
+
+bool has_key(const report_keyboard_t &report, uint16_t keycode) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t latency(uint32_t time, uint64_t press) {
+    const uint64_t end = (uint64_t)time * 1000;
+    return end > press ? end - press : 0;
+}
+
+} // namespace
+
+TraceStats Miryoku::replay_recorded(TestDriver &driver, const RecordedTrace &trace) {
+    std::vector<Report>      reports;
+    std::vector<LayerSample> layers;
+
+    EXPECT_CALL(driver, send_keyboard_mock(testing::_)).WillRepeatedly(testing::Invoke([&](const report_keyboard_t &report) { reports.push_back({now() + 1, report}); }));
+    m_on_scan = [&]() { layers.push_back({now(), layer_state}); };
+
+    std::vector<TraceEvent> events;
+    for (const RecordedEvent &event : trace.events) {
+        events.push_back({(uint32_t)(event.time / 1000), event.pos, event.pressed});
+    }
+    replay(events);
+    // the last presses resolve
+    advance_to(now() + TAPPING_TERM * 2);
+
+    m_on_scan = nullptr;
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    TraceStats stats = {};
+    for (size_t i = 0; i < trace.events.size(); i++) {
+        const RecordedEvent &press = trace.events[i];
+        if (!press.pressed || press.intent == INTENT_NONE) {
+            continue;
+        }
+        const uint16_t keycode = keycode_at(U_TEST_BASE, press.pos);
+        if (!IS_QK_MOD_TAP(keycode) && !IS_QK_LAYER_TAP(keycode)) {
+            ADD_FAILURE() << trace.name << ": tap or hold on a key that is not tap-hold, at " << +press.pos.row << " " << +press.pos.col;
+            continue;
+        }
+
+        // until the next press of the key, or the end of the trace
+        const uint32_t start   = press.time / 1000;
+        uint32_t       release = now();
+        uint32_t       next    = now();
+        for (size_t j = i + 1; j < trace.events.size(); j++) {
+            const RecordedEvent &event = trace.events[j];
+            if (event.pos.row == press.pos.row && event.pos.col == press.pos.col) {
+                if (event.pressed) {
+                    next = event.time / 1000;
+                    break;
+                }
+                release = event.time / 1000;
+            }
+        }
+
+        // The tap keycode or hold modifiers newly in a report, or the layer
+        // newly on, after the press.
+        const uint16_t    tap     = tap_keycode(keycode);
+        const uint8_t     mods    = hold_mods(keycode);
+        uint32_t          tap_at  = 0;
+        uint32_t          hold_at = 0;
+        report_keyboard_t before  = {};
+        for (const Report &report : reports) {
+            if (report.time > start && report.time <= next) {
+                if (!tap_at && has_key(report.report, tap) && !has_key(before, tap)) {
+                    tap_at = report.time;
+                }
+                if (!hold_at && mods && report.time <= release + 1 && (report.report.mods & mods) == mods && (before.mods & mods) != mods) {
+                    hold_at = report.time;
+                }
+            }
+            before = report.report;
+        }
+        if (IS_QK_LAYER_TAP(keycode)) {
+            const layer_state_t layer = (layer_state_t)1 << QK_LAYER_TAP_GET_LAYER(keycode);
+            layer_state_t       prior = 0;
+            for (const LayerSample &sample : layers) {
+                if (sample.time > start && sample.time <= release + 1 && (sample.state & layer) && !(prior & layer)) {
+                    hold_at = sample.time;
+                    break;
+                }
+                prior = sample.state;
+            }
+        }
+
+        stats.presses++;
+        TraceIntent resolved = INTENT_NONE;
+        if (tap_at && (!hold_at || tap_at <= hold_at)) {
+            resolved = INTENT_TAP;
+            stats.taps++;
+            stats.tap_latency_total += latency(tap_at, press.time);
+            stats.tap_latency_max = std::max(stats.tap_latency_max, latency(tap_at, press.time));
+        } else if (hold_at) {
+            resolved = INTENT_HOLD;
+            stats.holds++;
+            stats.hold_latency_total += latency(hold_at, press.time);
+            stats.hold_latency_max = std::max(stats.hold_latency_max, latency(hold_at, press.time));
+        }
+        if (resolved == INTENT_NONE) {
+            stats.unresolved++;
+        } else if (resolved != press.intent) {
+            stats.misfires++;
+        }
+    }
+    return stats;
+}
+
+void print_stats(const std::string &name, const TraceStats &stats) {
+    std::cout << name << ": " << stats.presses << " tap-hold presses, " << stats.misfires << " misfires, " << stats.unresolved << " unresolved" << std::endl;
+    std::cout << name << ": " << stats.taps << " taps, latency mean " << (stats.taps ? stats.tap_latency_total / stats.taps : 0) << " us, max " << stats.tap_latency_max << " us" << std::endl;
+    std::cout << name << ": " << stats.holds << " holds, latency mean " << (stats.holds ? stats.hold_latency_total / stats.holds : 0) << " us, max " << stats.hold_latency_max << " us" << std::endl;
+}
@@ -0,0 +1,82 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "test_fixture.hpp"
+#include "trace.hpp"
+
+class TestDriver;
+
+enum TraceHand : uint8_t {
+    HAND_LEFT,
+    HAND_RIGHT,
+};
+
+// Tap-hold resolution over one recorded trace, for presses marked tap or
+// hold.  Latencies run from the recorded press to the end of the scan that
+// sent the tap keycode or hold modifiers, or turned the held layer on.
+struct TraceStats {
+    uint32_t presses;
+    uint32_t misfires; // resolved against the intent
+    uint32_t unresolved;
+    uint32_t taps;
+    uint32_t holds;
+    uint64_t tap_latency_total; // us
+    uint64_t tap_latency_max;
+    uint64_t hold_latency_total;
+    uint64_t hold_latency_max;
+};
+
+// The Miryoku keymap, with the userspace features under test, behind the
+// test driver.  Each test starts from an idle keyboard, well past the flow tap
+// interval and the adaptive tapping term pause of the test before.  The keymap
+// follows the MIRYOKU_ALPHAS and MIRYOKU_LAYERS options of the run, so tests
+// find their keys in it rather than naming positions.
+class Miryoku : public TestFixture {
+   public:
+    Miryoku();
+
+   protected:
+    // Press and release keys at the given times, one scan after each event.
+    void replay(const std::vector<TraceEvent> &trace);
+
+    // Replay a recorded trace, at the 1 ms resolution of the test timer, and
+    // resolve its tap-hold presses from the reports sent and the layer state.
+    TraceStats replay_recorded(TestDriver &driver, const RecordedTrace &trace);
+
+    // Idle again, and restart the trace clock.
+    void settle(void);
+
+    uint16_t keycode_at(uint8_t layer, TracePos pos) const;
+    // The key with the keycode on the layer.
+    TracePos find_key(uint8_t layer, uint16_t keycode) const;
+    // The first plain alpha of the hand on the base layer, by row.
+    TracePos find_alpha(TraceHand hand) const;
+    // The base layer mod-tap of the hand holding the report modifier bits.
+    TracePos find_mod_tap(TraceHand hand, uint8_t mods) const;
+    // The base layer thumb key held for the layer.
+    TracePos find_thumb(uint8_t layer) const;
+
+    static TraceHand hand_of(TracePos pos);
+    static uint16_t  tap_keycode(uint16_t keycode);
+    // The report modifier bits held by a mod-tap.
+    static uint8_t hold_mods(uint16_t keycode);
+
+   private:
+    uint32_t now(void) const;
+    void     advance_to(uint32_t time);
+    void     scan(void);
+
+    uint32_t              m_start;
+    std::function<void()> m_on_scan;
+};
+
+void print_stats(const std::string &name, const TraceStats &stats);
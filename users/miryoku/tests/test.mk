@@ -0,0 +1,43 @@
+# Copyright 2026 pehweihang
+# https://github.com/pehweihang/qmk_userspace
+
+# Miryoku keymap under the qmk_firmware test framework, see test-miryoku in
+# the userspace Makefile.
+
+MIRYOKU_PATH := $(QMK_USERSPACE)/users/miryoku
+
+MOUSEKEY_ENABLE = yes
+EXTRAKEY_ENABLE = yes
+AUTO_SHIFT_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+KEY_OVERRIDE_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_keymap.c # keymaps
+
+OPT_DEFS += -DMIRYOKU_FLOW_TAP
+OPT_DEFS += -DMIRYOKU_ADAPTIVE_TAPPING_TERM
+OPT_DEFS += -DMIRYOKU_TEST_TRACES=\"$(MIRYOKU_PATH)/tests/traces\"
+
+# the option set of the run, given by test-miryoku-<ALPHAS>[_<LAYERS>]
+ifneq ($(strip $(MIRYOKU_ALPHAS)),)
+  OPT_DEFS += -DMIRYOKU_ALPHAS_$(MIRYOKU_ALPHAS)
+endif
+ifneq ($(strip $(MIRYOKU_LAYERS)),)
+  OPT_DEFS += -DMIRYOKU_LAYERS_$(MIRYOKU_LAYERS)
+endif
+
+# layers resolved by the generator, as with MIRYOKU_GENERATED_LAYERS=yes
+MIRYOKU_GENERATED_LAYERS_DIR := $(shell python3 $(MIRYOKU_PATH)/generate_layers.py $(if $(BUILD_DIR),$(BUILD_DIR),.build)/miryoku $(filter -DMIRYOKU_%,$(OPT_DEFS)))
+ifneq ($(MIRYOKU_GENERATED_LAYERS_DIR),)
+  OPT_DEFS += -DMIRYOKU_GENERATED_LAYERS
+  EXTRAINCDIRS += $(MIRYOKU_GENERATED_LAYERS_DIR)
+endif
+
+SRC += $(MIRYOKU_PATH)/features/bilateral_combinations.c
+SRC += $(MIRYOKU_PATH)/features/flow_tap.c
+SRC += $(MIRYOKU_PATH)/features/adaptive_tapping_term.c
+SRC += $(MIRYOKU_PATH)/features/scheduler.c
+
+EXTRAINCDIRS += $(MIRYOKU_PATH) $(QMK_USERSPACE)/users
+VPATH += $(MIRYOKU_PATH) $(QMK_USERSPACE)/users
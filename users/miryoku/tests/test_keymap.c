@@ -0,0 +1,17 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// The Miryoku keymap, built next to the dummy keymap of the test framework.
+// The test fixture feeds the keymap to the framework key by key, and runs the
+// keyboard post init once the keys are in place.
+#define keymaps u_test_keymaps
+#define keyboard_post_init_user u_keyboard_post_init_user
+
+#include "manna-harbour_miryoku.c"
+
+const uint8_t u_test_keymap_layers = sizeof(u_test_keymaps) / sizeof(u_test_keymaps[0]);
+
+#undef keymaps
+#undef keyboard_post_init_user
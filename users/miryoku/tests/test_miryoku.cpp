@@ -0,0 +1,197 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "keyboard_report_util.hpp"
+#include "miryoku_test.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "manna-harbour_miryoku.h"
+#include "features/flow_tap.h"
+
+uint16_t adaptive_tapping_term_get(void);
+}
+
+using testing::AnyNumber;
+using testing::InSequence;
+
+// Keys are found in the keymap of the run: the left home row Ctrl and Shift
+// mod-taps, the first plain alpha of each hand, and the thumb held for Nav.
+
+// Bilateral Combinations
+
+TEST_F(Miryoku, ModTapReleasedAloneTaps) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos shift = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LSFT));
+    const uint16_t tap   = tap_keycode(keycode_at(U_BASE, shift));
+
+    EXPECT_REPORT(driver, (tap));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, shift), up(50, shift)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Miryoku, ModTapSameHandRollTaps) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos ctl   = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LCTL));
+    const TracePos alpha = find_alpha(HAND_LEFT);
+
+    EXPECT_REPORT(driver, (tap_keycode(keycode_at(U_BASE, ctl))));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (keycode_at(U_BASE, alpha)));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, ctl), down(40, alpha), up(80, ctl), up(120, alpha)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Miryoku, ModTapOppositeHandHolds) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos shift = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LSFT));
+    const TracePos alpha = find_alpha(HAND_RIGHT);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, keycode_at(U_BASE, alpha)));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, shift), down(40, alpha), up(80, alpha), up(120, shift)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Bilateral Combinations, thumbs: Nav is reached from one thumb and worked
+// with the other hand, left or right with MIRYOKU_LAYERS=FLIP.
+
+TEST_F(Miryoku, ThumbLayerTapHoldsForItsHand) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos nav  = find_thumb(U_NAV);
+    const TracePos home = find_key(U_NAV, KC_HOME);
+    ASSERT_NE(hand_of(nav), hand_of(home));
+
+    EXPECT_REPORT(driver, (KC_HOME));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, nav), down(40, home), up(80, home), up(120, nav)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Miryoku, ThumbLayerTapTapsForTheOtherHand) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos nav   = find_thumb(U_NAV);
+    const TracePos alpha = find_alpha(hand_of(nav));
+
+    EXPECT_REPORT(driver, (tap_keycode(keycode_at(U_BASE, nav))));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (keycode_at(U_BASE, alpha)));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, nav), down(40, alpha), up(80, alpha), up(120, nav)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Flow Tap
+
+TEST_F(Miryoku, FlowTapReportsOnPress) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos alpha  = find_alpha(HAND_LEFT);
+    const TracePos ctl    = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LCTL));
+    const uint32_t flowed = flow_tap_get_stats()->flowed;
+
+    // Within the flow tap term of the alpha, Ctrl is a tap as soon as it is
+    // pressed.
+    EXPECT_REPORT(driver, (keycode_at(U_BASE, alpha)));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (tap_keycode(keycode_at(U_BASE, ctl))));
+    replay({down(0, alpha), up(30, alpha), down(60, ctl)});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(flow_tap_get_stats()->flowed, flowed + 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    replay({up(300, ctl)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Miryoku, FlowTapEndsAfterTimerWrapGap) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos alpha = find_alpha(HAND_LEFT);
+    const TracePos shift = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LSFT));
+
+    // 60 ms past a whole 16-bit timer period after the alpha is a pause, not a
+    // streak.
+    EXPECT_REPORT(driver, (keycode_at(U_BASE, alpha)));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, alpha), up(30, alpha), down(65536 + 60, shift), up(65536 + 60 + 300, shift)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Adaptive tapping term
+
+TEST_F(Miryoku, AdaptiveTermKeepsCeilingWhenSlow) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos shift = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LSFT));
+
+    // Held 170 ms after a pause, inside the 200 ms ceiling.
+    EXPECT_REPORT(driver, (tap_keycode(keycode_at(U_BASE, shift))));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({down(0, shift), up(170, shift)});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(adaptive_tapping_term_get(), TAPPING_TERM);
+}
+
+TEST_F(Miryoku, AdaptiveTermFallsWhenFast) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos alpha = find_alpha(HAND_LEFT);
+    const TracePos shift = find_mod_tap(HAND_LEFT, MOD_BIT(KC_LSFT));
+
+    // 200 words per minute, then a 200 ms gap, past the flow tap term.
+    std::vector<TraceEvent> trace;
+    for (uint32_t i = 0; i < 25; i++) {
+        trace.push_back(down(i * 60, alpha));
+        trace.push_back(up(i * 60 + 20, alpha));
+    }
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    replay(trace);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    replay({down(1640, shift)});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(adaptive_tapping_term_get(), 140);
+
+    // Held 170 ms, past the 140 ms floor.
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    replay({up(1810, shift)});
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Additional Features double tap guard
+
+TEST_F(Miryoku, DoubleTapGuardFiresOnSecondPressOnly) {
+    TestDriver     driver;
+    InSequence     s;
+    const TracePos nav = find_thumb(U_NAV);
+    const TracePos tap = find_key(U_NAV, TD(U_TD_U_TAP));
+
+    // Nav held past the tapping term, then the Tap guard tapped twice: the
+    // default layer changes on the second press, without waiting.
+    EXPECT_NO_REPORT(driver);
+    replay({down(0, nav), down(250, tap), up(270, tap), down(300, tap)});
+    EXPECT_EQ(default_layer_state, (layer_state_t)1 << U_TAP);
+
+    // A third tap within the tapping term starts a new dance instead of
+    // firing the guard again.
+    default_layer_set((layer_state_t)1 << U_BASE);
+    replay({up(320, tap), down(340, tap), up(360, tap), up(380, nav)});
+    EXPECT_EQ(default_layer_state, (layer_state_t)1 << U_BASE);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "features/scheduler.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Random sets, moves, and cancels of every timer against a plain list of
+// deadlines, across the timer_read32() wraparound.
+
+static std::vector<uint8_t> scheduler_fired;
+
+template <uint8_t TIMER>
+static void scheduler_on_due(void) {
+    scheduler_fired.push_back(TIMER);
+}
+
+static_assert(SCHEDULER_TIMERS == 3, "one callback per timer");
+
+static const scheduler_callback_t scheduler_on_due_of[SCHEDULER_TIMERS] = {
+    scheduler_on_due<0>,
+    scheduler_on_due<1>,
+    scheduler_on_due<2>,
+};
+
+TEST(Scheduler, RandomOperationsMatchDeadlineList) {
+    std::mt19937 random(2026);
+    bool         pending[SCHEDULER_TIMERS]  = {};
+    uint32_t     deadline[SCHEDULER_TIMERS] = {};
+
+    for (uint8_t timer = 0; timer < SCHEDULER_TIMERS; timer++) {
+        scheduler_cancel(timer);
+    }
+    scheduler_fired.clear();
+    set_time(UINT32_MAX - 50000);
+
+    for (uint32_t step = 0; step < 100000; step++) {
+        const uint8_t timer = random() % SCHEDULER_TIMERS;
+        switch (random() % 3) {
+            case 0: // set, or move if pending
+                deadline[timer] = timer_read32() + random() % 2000;
+                pending[timer]  = true;
+                scheduler_set(timer, deadline[timer], scheduler_on_due_of[timer]);
+                break;
+            case 1:
+                pending[timer] = false;
+                scheduler_cancel(timer);
+                break;
+            default: {
+                advance_time(random() % 300);
+                const uint32_t       now = timer_read32();
+                std::vector<uint8_t> due;
+                for (uint8_t t = 0; t < SCHEDULER_TIMERS; t++) {
+                    if (pending[t] && (int32_t)(now - deadline[t]) >= 0) {
+                        due.push_back(t);
+                        pending[t] = false;
+                    }
+                }
+                scheduler_fired.clear();
+                scheduler_task();
+                // earliest deadline first
+                for (size_t i = 1; i < scheduler_fired.size(); i++) {
+                    ASSERT_LE((int32_t)(deadline[scheduler_fired[i - 1]] - deadline[scheduler_fired[i]]), 0) << "step " << step;
+                }
+                std::sort(scheduler_fired.begin(), scheduler_fired.end());
+                ASSERT_EQ(scheduler_fired, due) << "step " << step;
+                break;
+            }
+        }
+
+        uint32_t next = UINT32_MAX;
+        for (uint8_t t = 0; t < SCHEDULER_TIMERS; t++) {
+            ASSERT_EQ(scheduler_pending(t), pending[t]) << "step " << step;
+            if (pending[t]) {
+                const int32_t remaining = deadline[t] - timer_read32();
+                next                    = std::min<uint32_t>(next, remaining > 0 ? remaining : 0);
+            }
+        }
+        ASSERT_EQ(scheduler_ms_until_next(), next) << "step " << step;
+    }
+}
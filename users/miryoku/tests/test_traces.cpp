@@ -0,0 +1,90 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "miryoku_test.hpp"
+#include "test_common.hpp"
+
+// set by test.mk
+#ifndef MIRYOKU_TEST_TRACES
+#    define MIRYOKU_TEST_TRACES "traces"
+#endif
+
+static std::vector<std::string> trace_files(void) {
+    std::vector<std::string> paths;
+    DIR                     *dir = opendir(MIRYOKU_TEST_TRACES);
+    if (dir == NULL) {
+        return paths;
+    }
+    for (struct dirent *entry; (entry = readdir(dir)) != NULL;) {
+        const std::string name = entry->d_name;
+        if (name.size() > 6 && name.compare(name.size() - 6, 6, ".trace") == 0) {
+            paths.push_back(MIRYOKU_TEST_TRACES "/" + name);
+        }
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+// Recorded traces
+
+TEST_F(Miryoku, RecordedTracesResolveAsIntended) {
+    const std::vector<std::string> paths = trace_files();
+    ASSERT_FALSE(paths.empty()) << "no traces in " MIRYOKU_TEST_TRACES;
+
+    for (const std::string &path : paths) {
+        SCOPED_TRACE(path);
+        RecordedTrace trace;
+        std::string   error;
+        ASSERT_TRUE(load_trace(path, trace, error)) << error;
+
+        TestDriver driver;
+        settle();
+        const TraceStats stats = replay_recorded(driver, trace);
+        print_stats(path, stats);
+        EXPECT_EQ(stats.unresolved, 0u);
+        EXPECT_LE(stats.misfires, trace.max_misfires);
+    }
+}
+
+// Trace loader
+
+static bool load(const std::string &text, RecordedTrace &trace, std::string &error) {
+    std::istringstream in(text);
+    return load_trace(in, "test.trace", trace, error);
+}
+
+TEST(TraceLoader, ReadsEventsIntentsAndMisfires) {
+    RecordedTrace trace;
+    std::string   error;
+    ASSERT_TRUE(load("# max-misfires 2\n\n1500 1 3 d hold # shift\n2999 0 7 d\n3000 0 7 u\n4000 1 3 u\n", trace, error)) << error;
+    EXPECT_EQ(trace.max_misfires, 2u);
+    ASSERT_EQ(trace.events.size(), 4u);
+    EXPECT_EQ(trace.events[0].time, 1500u);
+    EXPECT_EQ(trace.events[0].pos.row, 1);
+    EXPECT_EQ(trace.events[0].pos.col, 3);
+    EXPECT_TRUE(trace.events[0].pressed);
+    EXPECT_EQ(trace.events[0].intent, INTENT_HOLD);
+    EXPECT_EQ(trace.events[1].intent, INTENT_NONE);
+    EXPECT_FALSE(trace.events[3].pressed);
+}
+
+TEST(TraceLoader, RejectsMalformedTraces) {
+    RecordedTrace trace;
+    std::string   error;
+    EXPECT_FALSE(load("2000 1 3 d\n1000 1 3 u\n", trace, error));
+    EXPECT_EQ(error, "test.trace:2: time goes backwards");
+    EXPECT_FALSE(load("1000 4 0 d\n", trace, error));
+    EXPECT_FALSE(load("1000 1 3 u\n", trace, error));
+    EXPECT_FALSE(load("1000 1 3 d\n2000 1 3 d\n", trace, error));
+    EXPECT_FALSE(load("1000 1 3 d\n2000 1 3 u tap\n", trace, error));
+    EXPECT_FALSE(load("1000 1 3 d maybe\n", trace, error));
+    EXPECT_FALSE(load("1000 1 3\n", trace, error));
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trace.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#define U_TRACE_MAX_MISFIRES "# max-misfires"
+
+static bool u_trace_fail(const std::string &name, unsigned line, const std::string &message, std::string &error) {
+    error = name + ":" + std::to_string(line) + ": " + message;
+    return false;
+}
+
+bool load_trace(std::istream &in, const std::string &name, RecordedTrace &trace, std::string &error) {
+    bool     down[TRACE_ROWS][TRACE_COLS] = {};
+    unsigned number                       = 0;
+    uint64_t last                         = 0;
+
+    trace.name         = name;
+    trace.max_misfires = 0;
+    trace.events.clear();
+
+    for (std::string line; std::getline(in, line);) {
+        number++;
+        if (line.compare(0, sizeof(U_TRACE_MAX_MISFIRES) - 1, U_TRACE_MAX_MISFIRES) == 0) {
+            std::istringstream directive(line.substr(sizeof(U_TRACE_MAX_MISFIRES) - 1));
+            if (!(directive >> trace.max_misfires)) {
+                return u_trace_fail(name, number, "bad max-misfires", error);
+            }
+            continue;
+        }
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        uint64_t           time;
+        unsigned           row, col;
+        std::string        action, intent, extra;
+        if (!(fields >> time)) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                return u_trace_fail(name, number, "expected <time us> <row> <col> <d|u> [tap|hold]", error);
+            }
+            continue;
+        }
+        if (!(fields >> row >> col >> action) || (action != "d" && action != "u")) {
+            return u_trace_fail(name, number, "expected <time us> <row> <col> <d|u> [tap|hold]", error);
+        }
+        fields >> intent >> extra;
+        if (!extra.empty() || (!intent.empty() && intent != "tap" && intent != "hold")) {
+            return u_trace_fail(name, number, "expected tap or hold", error);
+        }
+        if (row >= TRACE_ROWS || col >= TRACE_COLS) {
+            return u_trace_fail(name, number, "key off the 4x10 matrix", error);
+        }
+        if (time < last) {
+            return u_trace_fail(name, number, "time goes backwards", error);
+        }
+
+        const bool pressed = action == "d";
+        if (!pressed && !intent.empty()) {
+            return u_trace_fail(name, number, "tap or hold on a release", error);
+        }
+        if (down[row][col] == pressed) {
+            return u_trace_fail(name, number, pressed ? "key already down" : "key not down", error);
+        }
+        down[row][col] = pressed;
+        last           = time;
+
+        RecordedEvent event;
+        event.time    = time;
+        event.pos     = {(uint8_t)row, (uint8_t)col};
+        event.pressed = pressed;
+        event.intent  = intent == "tap" ? INTENT_TAP : intent == "hold" ? INTENT_HOLD : INTENT_NONE;
+        trace.events.push_back(event);
+    }
+    return true;
+}
+
+bool load_trace(const std::string &path, RecordedTrace &trace, std::string &error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = path + ": cannot open";
+        return false;
+    }
+    return load_trace(in, path, trace, error);
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 pehweihang
+// https://github.com/pehweihang/qmk_userspace
+
+// This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 2 of the License, or (at your option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// the 4x10 test matrix, the same as LAYOUT_miryoku
+#define TRACE_ROWS 4
+#define TRACE_COLS 10
+
+struct TracePos {
+    uint8_t row;
+    uint8_t col;
+};
+
+struct TraceEvent {
+    uint32_t time; // ms from the start of the test
+    TracePos pos;
+    bool     pressed;
+};
+
+inline TraceEvent down(uint32_t time, TracePos pos) {
+    return {time, pos, true};
+}
+
+inline TraceEvent up(uint32_t time, TracePos pos) {
+    return {time, pos, false};
+}
+
+// What the typist meant by a tap-hold press.
+enum TraceIntent : uint8_t {
+    INTENT_NONE,
+    INTENT_TAP,
+    INTENT_HOLD,
+};
+
+struct RecordedEvent {
+    uint64_t    time; // us from the start of the recording
+    TracePos    pos;
+    bool        pressed;
+    TraceIntent intent;
+};
+
+struct RecordedTrace {
+    std::string                name;
+    std::vector<RecordedEvent> events;
+    uint32_t                   max_misfires;
+};
+
+// Load a trace recorded from a keyboard.  One event per line:
+//
+//   <time us> <row> <col> <d|u> [tap|hold]
+//
+// with times in order, tap or hold only on presses, and # comments.  A
+// "# max-misfires <n>" comment sets the misfires allowed for the trace.
+// Returns false with a "name:line: message" error on a malformed trace.
+bool load_trace(std::istream &in, const std::string &name, RecordedTrace &trace, std::string &error);
+bool load_trace(const std::string &path, RecordedTrace &trace, std::string &error);